@@ -0,0 +1,601 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file Bench.cpp
+ *
+ * @brief Benchmark driver for CPE400 Project Simulator
+ *
+ * @details Times the simulator hot paths (highestPower, findClosest,
+ *          generateRelay, updateBatteries, replaceDrone, sendPacket,
+ *          pipelineStep and consolidateRelays) across fleet sizes and disaster counts and
+ *          reports ns/op and ops/sec. Every case starts from the same seeded
+ *          fleet so runs can be compared against each other
+ *
+ * @version 1.0
+ *
+ * @Note Build and run with "make bench"
+ */
+
+// Header files ///////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include "simulator.h"
+#include "parallel.h"
+#include "rng.h"
+#include "kernels.h"
+#include "packets.h"
+#include "pipeline.h"
+#include "consolidate.h"
+
+using namespace std;
+
+// Global Constants ///////////////////////////////////////////////////////////
+
+static const uint64_t BENCH_SEED = 400;
+static const double MIN_TIMED_SECONDS = 0.1; //timed work per case
+static const double MAX_CASE_SECONDS = 1.0; //timed plus setup work per case
+static const int QUERY_POINTS = 4096;
+
+// Struct Definitions /////////////////////////////////////////////////////////
+
+/**
+ * @brief BenchState struct holds the fleets and inputs shared by the
+ *        benchmark cases for one fleet size and disaster count
+ *
+ * @details pristine is the freshly generated fleet and loaded is the same
+ *          fleet with a relay to every disaster. Cases work on fleet, a copy
+ *          of one of the two
+ */
+struct BenchState
+{
+    Fleet pristine;
+    Fleet loaded;
+    Fleet fleet;
+    vector<Disaster> disasters;
+    vector<Disaster> points; //random query coordinates
+    vector<int> airborne; //in flight Drones of fleet, for replaceDrone
+    vector<int> packetXPos; //packet sources, for sendPacketBatch
+    vector<int> packetYPos;
+    PacketBatch packets;
+    PacketPipeline pipe;
+    int cursor;
+};
+
+/**
+ * @brief BenchCase struct describes one benchmark
+ *
+ * @details setup runs untimed before every batch, run performs the given
+ *          number of operations and is timed
+ */
+struct BenchCase
+{
+    const char* name;
+    void (*setup)( BenchState& state );
+    void (*run)( BenchState& state, int ops );
+    int batchOps;
+};
+
+// Benchmark Definitions //////////////////////////////////////////////////////
+
+/**
+ * @brief Copies the fleet with relays to every disaster into state.fleet
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ * @return void
+ *
+ * @note Only copies once per case, later batches keep working on the result
+ */
+static void setupLoaded( BenchState& state )
+{
+    int cell;
+
+    selectKernels( detectKernels() );
+
+    if( state.cursor >= 0 )
+    {
+        return;
+    }
+
+    state.fleet = state.loaded;
+    state.cursor = 0;
+    resetPacketBatch( state.packets );
+    state.airborne.clear();
+    for( cell = 0; cell < (int)state.fleet.airborne.cells.size(); cell++ )
+    {
+        state.airborne.insert( state.airborne.end(),
+                               state.fleet.airborne.cells[cell].drones.begin(),
+                               state.fleet.airborne.cells[cell].drones.end() );
+    }
+}
+
+/**
+ * @brief Copies the fleet with relays to every disaster into state.fleet
+ *        and limits it to one worker thread
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ * @return void
+ *
+ * @note Gives the serial baseline for the threaded updateBatteries
+ */
+static void setupLoadedSerial( BenchState& state )
+{
+    setupLoaded( state );
+    state.fleet.workers = 1;
+}
+
+/**
+ * @brief Copies the fleet with relays to every disaster into state.fleet
+ *        and selects the scalar kernels
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ * @return void
+ *
+ * @note Gives the baseline for the vectorized kernels
+ */
+static void setupLoadedScalar( BenchState& state )
+{
+    setupLoaded( state );
+    selectKernels( KERNEL_SCALAR );
+}
+
+/**
+ * @brief Copies the fleet with relays to every disaster into state.fleet
+ *        and attaches an empty packet pipeline to it
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ * @return void
+ *
+ * @note Sending costs no battery, so no Drone is replaced between batches
+ */
+static void setupPipeline( BenchState& state )
+{
+    if( state.cursor < 0 )
+    {
+        pipelineReset( state.pipe );
+        state.pipe.packetsPerPercent = 0;
+    }
+
+    setupLoaded( state );
+    state.fleet.pipeline = &state.pipe;
+}
+
+/**
+ * @brief Copies the freshly generated fleet into state.fleet
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ * @return void
+ *
+ * @note Runs before every batch so each batch builds relays from scratch
+ */
+static void setupPristine( BenchState& state )
+{
+    selectKernels( detectKernels() );
+    state.fleet = state.pristine;
+    state.cursor = 0;
+}
+
+/**
+ * @brief Calls highestPower repeatedly on the loaded fleet
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ *            ops
+ *            Number of operations to perform
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void runHighestPower( BenchState& state, int ops )
+{
+    int op;
+    int sum = 0;
+
+    for( op = 0; op < ops; op++ )
+    {
+        sum += highestPower( state.fleet );
+    }
+
+    state.cursor += sum & 1;
+}
+
+/**
+ * @brief Calls findClosest for the pregenerated query points
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ *            ops
+ *            Number of operations to perform
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void runFindClosest( BenchState& state, int ops )
+{
+    int op;
+    int sum = 0;
+
+    for( op = 0; op < ops; op++ )
+    {
+        sum += findClosest( state.fleet,
+                            state.points[( state.cursor + op ) % QUERY_POINTS] );
+    }
+
+    state.cursor += ops + ( sum & 1 );
+}
+
+/**
+ * @brief Builds a relay to every disaster on a fresh fleet
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ *            ops
+ *            Number of operations to perform
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void runGenerateRelay( BenchState& state, int ops )
+{
+    int op;
+
+    for( op = 0; op < ops; op++ )
+    {
+        generateRelay( state.disasters[op % state.disasters.size()], state.fleet );
+    }
+}
+
+/**
+ * @brief Simulates one minute per operation with updateBatteries
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ *            ops
+ *            Number of operations to perform
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void runUpdateBatteries( BenchState& state, int ops )
+{
+    int op;
+
+    for( op = 0; op < ops; op++ )
+    {
+        updateBatteries( state.fleet, op );
+    }
+}
+
+/**
+ * @brief Runs one relay consolidation pass per operation
+ *
+ * @details Only the first pass can land Drones, the rest measure the cost
+ *          of finding nothing left to merge
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ *            ops
+ *            Number of operations to perform
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void runConsolidateRelays( BenchState& state, int ops )
+{
+    int op;
+
+    for( op = 0; op < ops; op++ )
+    {
+        consolidateRelays( state.fleet, op );
+    }
+}
+
+/**
+ * @brief Replaces in flight Drones one after another
+ *
+ * @details The replacement takes the replaced Drone's slot in the list of
+ *          in flight Drones so the next round replaces it in turn
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ *            ops
+ *            Number of operations to perform
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void runReplaceDrone( BenchState& state, int ops )
+{
+    int op, slot, newIndex;
+
+    for( op = 0; op < ops && !state.airborne.empty(); op++ )
+    {
+        slot = ( state.cursor + op ) % state.airborne.size();
+        newIndex = highestPower( state.fleet );
+        if( replaceDrone( state.airborne[slot], state.fleet, 0 ) )
+        {
+            state.airborne[slot] = newIndex;
+        }
+    }
+
+    state.cursor += ops;
+}
+
+/**
+ * @brief Sends a packet from each disaster in turn
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ *            ops
+ *            Number of operations to perform
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void runSendPacket( BenchState& state, int ops )
+{
+    int op;
+    const Disaster* dis;
+
+    for( op = 0; op < ops; op++ )
+    {
+        dis = &state.disasters[( state.cursor + op ) % state.disasters.size()];
+        sendPacketFrom( state.fleet, dis->xPos, dis->yPos );
+    }
+
+    state.cursor += ops;
+}
+
+/**
+ * @brief Sends one batch of packets cycling over the disasters
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ *            ops
+ *            Number of packets in the batch
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void runSendPacketBatch( BenchState& state, int ops )
+{
+    int op;
+    const Disaster* dis;
+
+    state.packetXPos.resize( ops );
+    state.packetYPos.resize( ops );
+    for( op = 0; op < ops; op++ )
+    {
+        dis = &state.disasters[( state.cursor + op ) % state.disasters.size()];
+        state.packetXPos[op] = dis->xPos;
+        state.packetYPos[op] = dis->yPos;
+    }
+
+    sendPacketBatch( state.fleet, state.packetXPos.data(),
+                     state.packetYPos.data(), ops, state.packets );
+    state.cursor += ops;
+}
+
+/**
+ * @brief Sends packets through the pipeline, one from each disaster a tick,
+ *        and runs it until every queue is empty
+ *
+ * @param in: state
+ *            Benchmark state
+ *
+ *            ops
+ *            Number of packets to send
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void runPipeline( BenchState& state, int ops )
+{
+    int op;
+    const Disaster* dis;
+
+    for( op = 0; op < ops; op++ )
+    {
+        dis = &state.disasters[( state.cursor + op ) % state.disasters.size()];
+        pipelineInject( state.fleet, state.pipe, dis->xPos, dis->yPos );
+        if( ( op + 1 ) % state.disasters.size() == 0 )
+        {
+            pipelineStep( state.fleet, state.pipe );
+        }
+    }
+
+    while( state.pipe.queued > 0 )
+    {
+        pipelineStep( state.fleet, state.pipe );
+    }
+
+    state.cursor += ops;
+}
+
+static const BenchCase BENCH_CASES[] =
+{
+    { "highestPower",    setupLoaded,        runHighestPower,     1024 },
+    { "findClosest",     setupLoaded,        runFindClosest,      1024 },
+    { "  (scalar)",      setupLoadedScalar,  runFindClosest,      1024 },
+    { "generateRelay",   setupPristine,      runGenerateRelay,    0 },
+    { "updateBatteries", setupLoaded,        runUpdateBatteries,  1 },
+    { "  (1 thread)",    setupLoadedSerial,  runUpdateBatteries,  1 },
+    { "  (scalar)",      setupLoadedScalar,  runUpdateBatteries,  1 },
+    { "replaceDrone",    setupLoaded,        runReplaceDrone,     64 },
+    { "sendPacket",      setupLoaded,        runSendPacket,       64 },
+    { "sendPacketBatch", setupLoaded,        runSendPacketBatch,  4096 },
+    { "pipeline",        setupPipeline,      runPipeline,         4096 },
+    { "consolidate",     setupLoaded,        runConsolidateRelays, 1 }
+};
+
+// Function Definitions ///////////////////////////////////////////////////////
+
+/**
+ * @brief Builds the benchmark state for one fleet size and disaster count
+ *
+ * @details The fleet and a generator for the coordinates are seeded with
+ *          BENCH_SEED so every run generates the same fleet, disaster
+ *          coordinates and query points
+ *
+ * @param in: state
+ *            Benchmark state to fill
+ *
+ *            fleetSize
+ *            Number of Drones in the fleet
+ *
+ *            disasterCount
+ *            Number of disasters to build relays to
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void prepareState( BenchState& state, int fleetSize, int disasterCount )
+{
+    Rng rng;
+    int index;
+
+    rngSeed( rng, BENCH_SEED );
+    generateFleet( state.pristine, fleetSize, BENCH_SEED );
+
+    state.disasters.resize( disasterCount );
+    for( index = 0; index < disasterCount; index++ )
+    {
+        state.disasters[index].xPos = rngRange( rng, 1, DEFAULT_MAP_SIZE );
+        state.disasters[index].yPos = rngRange( rng, 1, DEFAULT_MAP_SIZE );
+        state.disasters[index].disNum = index;
+        state.disasters[index].base = 0;
+    }
+
+    state.points.resize( QUERY_POINTS );
+    for( index = 0; index < QUERY_POINTS; index++ )
+    {
+        state.points[index].xPos = rngRange( rng, 1, DEFAULT_MAP_SIZE );
+        state.points[index].yPos = rngRange( rng, 1, DEFAULT_MAP_SIZE );
+    }
+
+    state.loaded = state.pristine;
+    for( index = 0; index < disasterCount; index++ )
+    {
+        generateRelay( state.disasters[index], state.loaded );
+    }
+}
+
+/**
+ * @brief Times one benchmark case and prints a result row
+ *
+ * @details Batches run until MIN_TIMED_SECONDS of timed work or
+ *          MAX_CASE_SECONDS overall, whichever comes first
+ *
+ * @param in: report
+ *            Stream the result row is printed to
+ *
+ *            bench
+ *            Case to run
+ *
+ *            state
+ *            Benchmark state for the current fleet size and disaster count
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void runCase( ostream& report, const BenchCase& bench, BenchState& state )
+{
+    chrono::steady_clock::time_point caseStart = chrono::steady_clock::now();
+    chrono::steady_clock::time_point batchStart;
+    double timed = 0, total = 0;
+    long ops = 0;
+    int batchOps = bench.batchOps > 0 ? bench.batchOps : state.disasters.size();
+
+    state.cursor = -1;
+
+    while( timed < MIN_TIMED_SECONDS && total < MAX_CASE_SECONDS )
+    {
+        bench.setup( state );
+        batchStart = chrono::steady_clock::now();
+        bench.run( state, batchOps );
+        timed += chrono::duration<double>( chrono::steady_clock::now()
+                                                    - batchStart ).count();
+        total = chrono::duration<double>( chrono::steady_clock::now()
+                                                    - caseStart ).count();
+        ops += batchOps;
+    }
+
+    report << left << setw( 17 ) << bench.name << right
+           << setw( 9 ) << state.pristine.size
+           << setw( 11 ) << state.disasters.size()
+           << setw( 12 ) << ops
+           << setw( 14 ) << fixed << setprecision( 1 ) << timed * 1e9 / ops
+           << setw( 16 ) << setprecision( 0 ) << ops / timed << '\n';
+    report.flush();
+}
+
+// Begin main /////////////////////////////////////////////////////////////////
+
+int main()
+{
+    static const int FLEET_SIZES[] = { 20, 1000, 100000, 1000000 };
+    static const int DISASTER_COUNTS[] = { 1, 16 };
+    ostream report( cout.rdbuf() );
+    ostringstream discard;
+    BenchState state;
+    unsigned int sizeIndex, countIndex, caseIndex;
+
+    //simulator output is not part of the measurement
+    cout.rdbuf( discard.rdbuf() );
+    cout.setstate( ios::badbit );
+
+    report << "kernels: " << kernelName( detectKernels() ) << ", workers: "
+           << defaultWorkers() << '\n';
+    report << left << setw( 17 ) << "benchmark" << right << setw( 9 ) << "fleet"
+           << setw( 11 ) << "disasters" << setw( 12 ) << "ops"
+           << setw( 14 ) << "ns/op" << setw( 16 ) << "ops/sec" << '\n';
+
+    for( sizeIndex = 0; sizeIndex < sizeof( FLEET_SIZES ) / sizeof( int ); sizeIndex++ )
+    {
+        for( countIndex = 0; countIndex < sizeof( DISASTER_COUNTS ) / sizeof( int );
+                                                                countIndex++ )
+        {
+            prepareState( state, FLEET_SIZES[sizeIndex], DISASTER_COUNTS[countIndex] );
+
+            for( caseIndex = 0; caseIndex < sizeof( BENCH_CASES ) / sizeof( BenchCase );
+                                                                caseIndex++ )
+            {
+                runCase( report, BENCH_CASES[caseIndex], state );
+            }
+        }
+    }
+
+    return 0;
+}
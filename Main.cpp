@@ -6,10 +6,11 @@
  *        Project 2: Using an energy‐constrained relay network cluster to 
  *        transmit disaster area information to Command and Control Center
  * 
- * @details Contains struct definitions, function definitions and main function
+ * @details Contains the main function, which drives a Simulation from the
+ *          command line, a scenario or the interactive menu
  *
- * @version 1.5
- *          Newest Addition: printMap function
+ * @version 2.0
+ *          Newest Addition: Simulation engine object in libsim.a
  *
  * @Note None
  */
@@ -17,74 +18,286 @@
 // Header files ///////////////////////////////////////////////////////////////
 
 #include <iostream>
+#include <fstream>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <vector>
-#include "simulator.cpp"
+#include "simulation.h"
+#include "simulator.h"
+#include "instrument.h"
+#include "kernels.h"
+#include "scenario.h"
+#include "telemetry.h"
 
 using namespace std;
 
 // Begin main /////////////////////////////////////////////////////////////////
 
-int main()
+int main( int argc, char* argv[] )
 {
-    Drone* fleet;
-    vector<Disaster> disasterSet;
+    Simulation sim;
     Disaster dis;
-    int disCount = 0;
     int choice = 1;
-    bool relayCreated;
-    srand(time(NULL));
+    int fleetSize = DEFAULT_FLEET_SIZE;
+    int workers = 0; //0 keeps one per hardware thread
+    int argIndex, base, baseX, baseY, drones;
+    int reserve;
+    int mapSize = DEFAULT_MAP_SIZE;
+    int range = DEFAULT_RANGE;
+    int consolidateEvery = -1; //-1 keeps the Fleet's own
+    const char* scenarioFile = NULL;
+    const char* snapshotFile = NULL;
+    const char* telemetryFile = NULL;
+    Telemetry telemetry;
+    bool quiet = false;
+    bool stats = false;
+    bool argsValid = true;
+    ifstream scenario;
+    bool scenarioValid;
+    int result = 0;
+    uint64_t seed = time( NULL ); //each base station takes the next seed
     
-    generateFleet( fleet );
-    while( choice != 0 )
+    //--base builds its Fleet as soon as it is read, so find the seed first
+    for( argIndex = 1; argIndex + 1 < argc; argIndex++ )
     {
-        if( choice == 1 )
+        if( strcmp( argv[argIndex], "--seed" ) == 0 )
+        {
+            seed = strtoull( argv[argIndex + 1], NULL, 10 );
+        }
+    }
+    
+    //[fleet size] or --fleet <n>, --base <x>,<y>,<drones>[,<reserve %>] once
+    //per base station instead of one fleet at (0,0), --map <size> and
+    //--range <units> to resize the map and Drone links, --consolidate
+    //<minutes> to merge relays that often, --seed <n> to repeat a run,
+    //--threads <n>, --scalar to skip the vector kernels, --scenario
+    //<file> ("-" for stdin), --restore <snapshot>, --telemetry <log> to
+    //record events, --quiet to stop printing them and --stats to print the
+    //instrumentation summary at exit
+    for( argIndex = 1; argIndex < argc; argIndex++ )
+    {
+        if( strcmp( argv[argIndex], "--fleet" ) == 0 && argIndex + 1 < argc )
         {
-            makeDisaster( dis, disCount );
-            relayCreated = generateRelay( dis, fleet );
-            if( relayCreated )
+            fleetSize = atoi( argv[++argIndex] );
+        }
+        else if( strcmp( argv[argIndex], "--seed" ) == 0 && argIndex + 1 < argc )
+        {
+            argIndex++; //read before the loop
+        }
+        else if( strcmp( argv[argIndex], "--base" ) == 0 && argIndex + 1 < argc )
+        {
+            reserve = DEFAULT_RESERVE;
+            argsValid = sscanf( argv[++argIndex], "%d,%d,%d,%d", &baseX,
+                                &baseY, &drones, &reserve ) >= 3
+                        && baseX >= 0 && baseY >= 0 && drones > 0
+                        && reserve >= 0 && reserve <= 100;
+            
+            if( argsValid )
             {
-                disCount++;
-                disasterSet.push_back(dis);
-                cout << endl << "Relay network successfully established" << endl;
+                sim.addBase( baseX, baseY, drones, reserve, seed++ );
             }
-            else
+        }
+        else if( strcmp( argv[argIndex], "--map" ) == 0 && argIndex + 1 < argc )
+        {
+            mapSize = atoi( argv[++argIndex] );
+            argsValid = mapSize > 0;
+        }
+        else if( strcmp( argv[argIndex], "--range" ) == 0 && argIndex + 1 < argc )
+        {
+            range = atoi( argv[++argIndex] );
+            argsValid = range >= MIN_RANGE;
+        }
+        else if( strcmp( argv[argIndex], "--consolidate" ) == 0 && argIndex + 1 < argc )
+        {
+            consolidateEvery = atoi( argv[++argIndex] );
+            argsValid = consolidateEvery >= 0;
+        }
+        else if( strcmp( argv[argIndex], "--threads" ) == 0 && argIndex + 1 < argc )
+        {
+            workers = max( 1, atoi( argv[++argIndex] ) );
+        }
+        else if( strcmp( argv[argIndex], "--scalar" ) == 0 )
+        {
+            selectKernels( KERNEL_SCALAR );
+        }
+        else if( strcmp( argv[argIndex], "--scenario" ) == 0 && argIndex + 1 < argc )
+        {
+            scenarioFile = argv[++argIndex];
+        }
+        else if( strcmp( argv[argIndex], "--restore" ) == 0 && argIndex + 1 < argc )
+        {
+            snapshotFile = argv[++argIndex];
+        }
+        else if( strcmp( argv[argIndex], "--telemetry" ) == 0 && argIndex + 1 < argc )
+        {
+            telemetryFile = argv[++argIndex];
+        }
+        else if( strcmp( argv[argIndex], "--quiet" ) == 0 )
+        {
+            quiet = true;
+        }
+        else if( strcmp( argv[argIndex], "--stats" ) == 0 )
+        {
+            stats = true;
+        }
+        else
+        {
+            fleetSize = atoi( argv[argIndex] );
+        }
+        
+        if( fleetSize < 1 || !argsValid )
+        {
+            cout << "Usage: " << argv[0]
+                 << " [fleet size] [--fleet <n>]"
+                 << " [--base <x>,<y>,<drones>[,<reserve %>]]..."
+                 << " [--map <size>] [--range <units>]"
+                 << " [--consolidate <minutes>] [--seed <n>]"
+                 << " [--threads <n>] [--scalar]"
+                 << " [--scenario <file>|-] [--restore <snapshot>]"
+                 << " [--telemetry <log>] [--quiet] [--stats]" << '\n';
+            return 1;
+        }
+    }
+    
+    if( snapshotFile != NULL )
+    {
+        if( !sim.restore( snapshotFile ) )
+        {
+            cerr << "Unable to load snapshot " << snapshotFile << '\n';
+            return 1;
+        }
+    }
+    else
+    {
+        if( sim.getNetwork().partitions.empty() )
+        {
+            sim.addBase( 0, 0, fleetSize, DEFAULT_RESERVE, seed );
+        }
+        
+        for( base = 0; base < (int)sim.getNetwork().partitions.size(); base++ )
+        {
+            if( sim.getNetwork().partitions[base].baseX > mapSize
+                 || sim.getNetwork().partitions[base].baseY > mapSize )
             {
-                cout << endl 
-                     << "Failed to generate relay network: not enough drones available"
-                     << endl << endl;
+                cerr << "Base station #" << base << " is off the map" << '\n';
+                return 1;
             }
         }
         
+        sim.setMap( mapSize, range );
+    }
+    
+    if( consolidateEvery >= 0 )
+    {
+        sim.setConsolidation( consolidateEvery );
+    }
+    
+    if( workers > 0 )
+    {
+        sim.setWorkers( workers );
+    }
+    
+    sim.setConsole( !quiet );
+    
+    if( scenarioFile != NULL && strcmp( scenarioFile, "-" ) != 0 )
+    {
+        scenario.open( scenarioFile );
+        if( !scenario )
+        {
+            cerr << "Unable to open scenario file " << scenarioFile << '\n';
+            return 1;
+        }
+    }
+    
+    if( telemetryFile != NULL )
+    {
+        if( !telemetryOpen( telemetry, telemetryFile ) )
+        {
+            cerr << "Unable to create telemetry log " << telemetryFile << '\n';
+            return 1;
+        }
+        sim.setTelemetry( &telemetry );
+    }
+    
+    if( scenarioFile != NULL )
+    {
+        ios::sync_with_stdio( false );
+        
+        if( strcmp( scenarioFile, "-" ) == 0 )
+        {
+            scenarioValid = sim.runScenario( cin );
+        }
+        else
+        {
+            scenarioValid = sim.runScenario( scenario );
+        }
+        
+        result = scenarioValid ? 0 : 1;
+    }
+    
+    while( scenarioFile == NULL && choice != 0 )
+    {
+        if( choice == 1 )
+        {
+            makeDisaster( dis, sim.getDisasters().size(),
+                          sim.getNetwork().partitions[0].mapSize );
+            sim.addDisaster( dis.xPos, dis.yPos );
+        }
+        
         else if( choice == 2 )
         {
-            displayRelay( fleet, disCount );
+            sim.displayRelay();
         }
         
         else if( choice == 3 )
         {
-            simulateTime( fleet );
+            simulateTime( sim.getNetwork() );
         }
         
         else if( choice == 4 )
         {
-            if( !sendPacket( fleet ) )
+            if( !sendPacket( sim.getNetwork() ) )
             {
-                cout << endl
-                     << "Unable to connect to fleet from given coordinates" << endl;
+                cout << '\n'
+                     << "Unable to connect to fleet from given coordinates" << '\n';
             }
         }
 
         else if( choice == 5 )
         {
-            printMap( fleet, disasterSet );            
+            sim.printMap();
+        }
+
+        else if( choice == 6 )
+        {
+            instrumentReport( cout );
+        }
+
+        else if( choice == 7 )
+        {
+            if( !sim.resolveDisaster( chooseDisaster() ) )
+            {
+                cout << '\n' << "No active disaster with that number" << '\n';
+            }
         }
         
         choice = getUserChoice();
     }
 
-    delete[] fleet;
-    fleet = NULL;
-    return 0;
+    //every event has to reach the log before exiting
+    if( telemetryFile != NULL )
+    {
+        sim.setTelemetry( NULL );
+        telemetryClose( telemetry );
+    }
+
+    if( stats )
+    {
+        instrumentReport( cout );
+    }
+
+    cout.flush();
+    return result;
 }
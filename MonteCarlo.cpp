@@ -0,0 +1,321 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file MonteCarlo.cpp
+ *
+ * @brief Monte Carlo scenario runner for CPE400 Project Simulator
+ *
+ * @details Runs many independent simulator instances over a grid of Drone
+ *          ranges, reserves and replacement thresholds, and reports the
+ *          average coverage, failed relays, replacements, repairs and
+ *          consolidated Drones of every setting. Every setting runs the same
+ *          seeds, so settings are compared on identical scenarios.
+ *          Instances share nothing, so they are handed to a pool of worker
+ *          threads and throughput grows with the number of cores
+ *
+ * @version 1.0
+ *
+ * @Note Build and run with "make montecarlo"
+ */
+
+// Header files ///////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "simulator.h"
+#include "parallel.h"
+#include "rng.h"
+#include "eventengine.h"
+
+using namespace std;
+
+// Global Constants ///////////////////////////////////////////////////////////
+
+static const int RANGES[] = { 15, 20, 25 };
+static const int RESERVES[] = { 10, 20, 30 };
+static const int LOW_BATTERIES[] = { 15, 25, 35 };
+static const int DEFAULT_RUNS = 100; //instances per setting
+static const int DEFAULT_DISASTERS = 20; //per instance
+static const int ARRIVAL_MINUTES = 30; //between Disasters
+static const int TAIL_MINUTES = 240; //simulated after the last Disaster
+
+// Struct Definitions /////////////////////////////////////////////////////////
+
+/**
+ * @brief MonteCarloSetting struct holds the tuned parameters of one group of
+ *        instances
+ */
+struct MonteCarloSetting
+{
+    int range;
+    int reserve;
+    int lowBattery;
+    int consolidateEvery; //the same for every setting, see --consolidate
+};
+
+/**
+ * @brief MonteCarloResult struct holds the outcome of one instance
+ *
+ * @details A Disaster counts as covered when a packet sent from it at the
+ *          end of the run would reach the base over Drones that still have
+ *          charge
+ */
+struct MonteCarloResult
+{
+    int covered;
+    int failedRelays;
+    long replacements;
+    long replaceFailures;
+    long repairs;
+    long consolidated;
+};
+
+// Function Definitions ///////////////////////////////////////////////////////
+
+/**
+ * @brief Decides whether a packet sent from a Disaster would reach the base
+ *
+ * @details Follows the path sendPacketFrom takes: the closest in flight
+ *          Drone, if in reach, then previous links to the base station.
+ *          Every Drone on the path needs some charge left
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            dis
+ *            Disaster to check
+ *
+ * @return bool True if the Disaster is covered
+ *
+ * @note None
+ */
+static bool isCovered( const Fleet& fleet, const Disaster& dis )
+{
+    int current = findClosest( fleet, dis );
+
+    if( current < 0 || !inReach( fleet, fleet.xPos[current],
+                                 fleet.yPos[current], dis.xPos, dis.yPos ) )
+    {
+        return false;
+    }
+
+    while( current >= 0 )
+    {
+        if( fleet.battery[current] <= 0 )
+        {
+            return false;
+        }
+        current = fleet.previous[current];
+    }
+
+    return true;
+}
+
+/**
+ * @brief Runs one simulator instance from a fresh Fleet to the end
+ *
+ * @details Disasters arrive at random map positions every ARRIVAL_MINUTES
+ *          and get a relay if the Fleet can build one, then TAIL_MINUTES
+ *          more are simulated. Everything random comes from the Fleet's
+ *          generator, seeded with seed, so an instance gives the same result
+ *          on any thread
+ *
+ * @param in: setting
+ *            Range, reserve and replacement threshold of the Fleet
+ *
+ *            fleetSize
+ *            Number of Drones in the Fleet
+ *
+ *            disasterCount
+ *            Number of Disasters that arrive
+ *
+ *            seed
+ *            Seed of the Fleet and the Disaster positions
+ *
+ *            result
+ *            Outcome of the instance
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void runInstance( const MonteCarloSetting& setting, int fleetSize,
+                         int disasterCount, uint64_t seed,
+                         MonteCarloResult& result )
+{
+    Fleet fleet;
+    vector<Disaster> disasters;
+    Disaster dis;
+    int index;
+
+    generateFleet( fleet, fleetSize, seed );
+    setMap( fleet, DEFAULT_MAP_SIZE, setting.range );
+    fleet.reserve = setting.reserve;
+    fleet.lowBattery = setting.lowBattery;
+    fleet.consolidateEvery = setting.consolidateEvery;
+    fleet.workers = 1;
+    fleet.console = false;
+    result.failedRelays = 0;
+
+    for( index = 0; index < disasterCount; index++ )
+    {
+        advanceTime( fleet, ARRIVAL_MINUTES );
+
+        dis.xPos = rngRange( fleet.rng, 1, DEFAULT_MAP_SIZE );
+        dis.yPos = rngRange( fleet.rng, 1, DEFAULT_MAP_SIZE );
+        dis.disNum = disasters.size();
+        dis.base = 0;
+        disasters.push_back( dis );
+
+        if( !generateRelay( dis, fleet ) )
+        {
+            result.failedRelays++;
+        }
+    }
+
+    advanceTime( fleet, TAIL_MINUTES );
+
+    result.covered = 0;
+    for( index = 0; index < disasterCount; index++ )
+    {
+        if( isCovered( fleet, disasters[index] ) )
+        {
+            result.covered++;
+        }
+    }
+    result.replacements = fleet.replacements;
+    result.replaceFailures = fleet.replaceFailures;
+    result.repairs = fleet.repairs;
+    result.consolidated = fleet.consolidated;
+}
+
+// Begin main /////////////////////////////////////////////////////////////////
+
+int main( int argc, char** argv )
+{
+    vector<MonteCarloSetting> settings;
+    vector<MonteCarloResult> results;
+    MonteCarloSetting setting;
+    chrono::steady_clock::time_point start;
+    double seconds, covered, failedRelays, replacements, replaceFailures;
+    double repairs, consolidated;
+    int runs = DEFAULT_RUNS;
+    int disasterCount = DEFAULT_DISASTERS;
+    int fleetSize = DEFAULT_FLEET_SIZE;
+    int workers = defaultWorkers();
+    uint64_t seed = 400;
+    int argIndex, rangeIndex, reserveIndex, lowIndex, index, run;
+
+    setting.consolidateEvery = DEFAULT_CONSOLIDATE_EVERY;
+
+    //--runs <instances per setting>, --disasters <n>, --fleet <n>,
+    //--threads <n>, --seed <first seed>, --consolidate <minutes>
+    for( argIndex = 1; argIndex < argc; argIndex++ )
+    {
+        if( strcmp( argv[argIndex], "--runs" ) == 0 && argIndex + 1 < argc )
+        {
+            runs = atoi( argv[++argIndex] );
+        }
+        else if( strcmp( argv[argIndex], "--disasters" ) == 0 && argIndex + 1 < argc )
+        {
+            disasterCount = atoi( argv[++argIndex] );
+        }
+        else if( strcmp( argv[argIndex], "--fleet" ) == 0 && argIndex + 1 < argc )
+        {
+            fleetSize = atoi( argv[++argIndex] );
+        }
+        else if( strcmp( argv[argIndex], "--threads" ) == 0 && argIndex + 1 < argc )
+        {
+            workers = max( 1, atoi( argv[++argIndex] ) );
+        }
+        else if( strcmp( argv[argIndex], "--seed" ) == 0 && argIndex + 1 < argc )
+        {
+            seed = strtoull( argv[++argIndex], NULL, 10 );
+        }
+        else if( strcmp( argv[argIndex], "--consolidate" ) == 0 && argIndex + 1 < argc )
+        {
+            setting.consolidateEvery = atoi( argv[++argIndex] );
+        }
+        else
+        {
+            runs = 0;
+        }
+
+        if( runs < 1 || disasterCount < 1 || fleetSize < 1
+             || setting.consolidateEvery < 0 )
+        {
+            cout << "Usage: " << argv[0] << " [--runs <n>] [--disasters <n>]"
+                 << " [--fleet <n>] [--threads <n>] [--seed <n>]"
+                 << " [--consolidate <minutes>]" << '\n';
+            return 1;
+        }
+    }
+
+    for( rangeIndex = 0; rangeIndex < 3; rangeIndex++ )
+    {
+        for( reserveIndex = 0; reserveIndex < 3; reserveIndex++ )
+        {
+            for( lowIndex = 0; lowIndex < 3; lowIndex++ )
+            {
+                setting.range = RANGES[rangeIndex];
+                setting.reserve = RESERVES[reserveIndex];
+                setting.lowBattery = LOW_BATTERIES[lowIndex];
+                settings.push_back( setting );
+            }
+        }
+    }
+
+    //instance i runs setting i / runs with seed + i % runs, so every
+    //setting sees the same scenarios
+    results.resize( settings.size() * runs );
+    start = chrono::steady_clock::now();
+    parallelQueue( results.size(), workers, [&]( int, int item )
+    {
+        runInstance( settings[item / runs], fleetSize, disasterCount,
+                     seed + item % runs, results[item] );
+    } );
+    seconds = chrono::duration<double>( chrono::steady_clock::now()
+                                                    - start ).count();
+
+    cout << results.size() << " instances of " << fleetSize << " drones and "
+         << disasterCount << " disasters on " << workers << " threads in "
+         << fixed << setprecision( 2 ) << seconds << " s ("
+         << setprecision( 0 ) << results.size() / seconds << " instances/s)"
+         << '\n' << '\n';
+    cout << setw( 6 ) << "range" << setw( 9 ) << "reserve" << setw( 6 ) << "low"
+         << setw( 11 ) << "coverage" << setw( 15 ) << "failed relays"
+         << setw( 14 ) << "replacements" << setw( 17 ) << "replace failed"
+         << setw( 10 ) << "repairs" << setw( 14 ) << "consolidated"
+         << '\n';
+
+    for( index = 0; index < (int)settings.size(); index++ )
+    {
+        covered = failedRelays = replacements = replaceFailures = repairs = 0;
+        consolidated = 0;
+        for( run = index * runs; run < ( index + 1 ) * runs; run++ )
+        {
+            covered += results[run].covered;
+            failedRelays += results[run].failedRelays;
+            replacements += results[run].replacements;
+            replaceFailures += results[run].replaceFailures;
+            repairs += results[run].repairs;
+            consolidated += results[run].consolidated;
+        }
+
+        cout << setw( 6 ) << settings[index].range
+             << setw( 9 ) << settings[index].reserve
+             << setw( 6 ) << settings[index].lowBattery
+             << setw( 10 ) << setprecision( 1 )
+             << 100 * covered / ( (double)runs * disasterCount ) << '%'
+             << setw( 15 ) << setprecision( 2 ) << failedRelays / runs
+             << setw( 14 ) << replacements / runs
+             << setw( 17 ) << replaceFailures / runs
+             << setw( 10 ) << repairs / runs
+             << setw( 14 ) << consolidated / runs << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,386 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file bases.cpp
+ *
+ * @details Implementation file for the base station network which provides
+ *          function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef BASES_CPP
+#define BASES_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+#include "bases.h"
+#include "parallel.h"
+#include "pool.h"
+#include "spatialgrid.h"
+#include "eventengine.h"
+#include "packets.h"
+#include "planner.h"
+#include "simulator.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Removes every base station from a network
+ *
+ * @details The network uses one thread per hardware thread until told
+ *          otherwise
+ *
+ * @param in: network
+ *            Network to empty
+ *
+ * @return void
+ *
+ * @note None
+ */
+void networkClear( BaseNetwork& network )
+{
+    network.partitions.clear();
+    network.workers = defaultWorkers();
+    poolReset( network.disasters, 0 );
+}
+
+/**
+ * @brief Rebuilds the pool of Disaster numbers from the Disaster set
+ *
+ * @details Needed after the Disaster set is replaced, as when a snapshot is
+ *          loaded. Every slot of the set is in the pool and the resolved ones
+ *          are free, the lowest reused first
+ *
+ * @param in: network
+ *            Network whose free list is rebuilt
+ *
+ *            disasterSet
+ *            Vector containing all disaster data, resolved ones with
+ *            disNum -1
+ *
+ * @return void
+ *
+ * @note O(disasters)
+ */
+void networkFreeDisasters( BaseNetwork& network,
+                           const vector<Disaster>& disasterSet )
+{
+    int disIndex;
+
+    poolReset( network.disasters, disasterSet.size() );
+    for( disIndex = disasterSet.size() - 1; disIndex >= 0; disIndex-- )
+    {
+        if( disasterSet[disIndex].disNum < 0 )
+        {
+            poolRelease( network.disasters, disIndex );
+        }
+    }
+    network.disasters.peak = network.disasters.used;
+}
+
+/**
+ * @brief Sets aside room for a number of Drones per base station and
+ *        active Disasters
+ *
+ * @details Every partition is reserved with reserveFleet, and the Disaster
+ *          set and disasters pool with it, so opening and closing Disasters
+ *          and adding and losing Drones within those numbers does not
+ *          allocate
+ *
+ * @param in: network
+ *            Network of all base stations
+ *
+ *            disasterSet
+ *            Vector containing all disaster data
+ *
+ *            drones
+ *            Most Drones any one base station will hold
+ *
+ *            disasters
+ *            Most Disasters that will be active at once
+ *
+ * @return void
+ *
+ * @note O(partitions * ( drones + disasters ))
+ */
+void networkReserve( BaseNetwork& network, vector<Disaster>& disasterSet,
+                     int drones, int disasters )
+{
+    int base;
+
+    for( base = 0; base < (int)network.partitions.size(); base++ )
+    {
+        reserveFleet( network.partitions[base], drones, disasters );
+    }
+
+    disasterSet.reserve( disasters );
+    poolReserve( network.disasters, disasters );
+    network.plan.xPos.reserve( drones );
+    network.plan.yPos.reserve( drones );
+    network.plan.found.reserve( drones );
+}
+
+/**
+ * @brief Adds a Command and Control Center with a Fleet of its own
+ *
+ * @param in: network
+ *            Network to add to
+ *
+ *            xPos
+ *            x coordinate of the base station
+ *
+ *            yPos
+ *            y coordinate of the base station
+ *
+ *            drones
+ *            Number of Drones in the base station's Fleet
+ *
+ *            reserve
+ *            Percent of the Drones kept at the base station to replace
+ *            others
+ *
+ *            seed
+ *            Seed of the starting batteries, see generateFleet
+ *
+ * @return void
+ *
+ * @note The new partition takes the next partition number
+ */
+void networkAddBase( BaseNetwork& network, int xPos, int yPos, int drones,
+                     int reserve, uint64_t seed )
+{
+    network.partitions.push_back( Fleet() );
+    generateFleet( network.partitions.back(), drones, seed, xPos, yPos );
+    network.partitions.back().reserve = reserve;
+}
+
+/**
+ * @brief Chooses the base station that can serve a Disaster with the
+ *        fewest new Drones
+ *
+ * @details Every partition plans the relay it would build with planRelay.
+ *          A partition with no charged Drone, that cannot plan a relay, or
+ *          whose plan would dig into its reserve, is skipped. The rest are ranked by new Drones, then
+ *          by the hops a packet takes to reach the base, then by partition
+ *          number
+ *
+ * @param in: network
+ *            Network of all base stations
+ *
+ *            xPos
+ *            x coordinate of the Disaster
+ *
+ *            yPos
+ *            y coordinate of the Disaster
+ *
+ * @return int partition to serve the Disaster, -1 if none can
+ *
+ * @note O(partitions * planRelay)
+ */
+int networkCheapest( BaseNetwork& network, int xPos, int yPos )
+{
+    RelayPlan& plan = network.plan;
+    int best = -1;
+    int bestDrones = 0, bestHops = 0;
+    int base, drones;
+
+    for( base = 0; base < (int)network.partitions.size(); base++ )
+    {
+        Fleet& fleet = network.partitions[base];
+
+        if( highestPower( fleet ) < 0 )
+        {
+            continue;
+        }
+
+        if( !planRelay( fleet, xPos, yPos, plan ) )
+        {
+            continue;
+        }
+
+        drones = plan.xPos.size();
+        if( !withinReserve( fleet, drones ) )
+        {
+            continue;
+        }
+
+        if( best < 0 || drones < bestDrones
+             || ( drones == bestDrones && plan.hops < bestHops ) )
+        {
+            best = base;
+            bestDrones = drones;
+            bestHops = plan.hops;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Chooses the partition a packet sent from a point enters
+ *
+ * @details The packet goes to the closest in flight Drone of any
+ *          partition, ties go to the lower partition number. Whether that
+ *          Drone is in range is left to the partition
+ *
+ * @param in: network
+ *            Network of all base stations
+ *
+ *            xPos
+ *            x coordinate the packet is sent from
+ *
+ *            yPos
+ *            y coordinate the packet is sent from
+ *
+ * @return int partition the packet enters, -1 if no Drone is in flight
+ *
+ * @note O(partitions * findClosest)
+ */
+int networkRoute( const BaseNetwork& network, int xPos, int yPos )
+{
+    int best = -1;
+    long bestDist = LONG_MAX; //squared
+    long x, y;
+    int base, closest;
+
+    for( base = 0; base < (int)network.partitions.size(); base++ )
+    {
+        const Fleet& fleet = network.partitions[base];
+
+        closest = gridNearest( fleet, xPos, yPos );
+        if( closest < 0 )
+        {
+            continue;
+        }
+
+        x = fleet.xPos[closest] - xPos;
+        y = fleet.yPos[closest] - yPos;
+        if( x * x + y * y < bestDist )
+        {
+            best = base;
+            bestDist = x * x + y * y;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Simulates the given number of minutes on every partition
+ *
+ * @details Partitions share no state, so each runs advanceTime on its own
+ *          thread, up to network.workers at once. When any partition prints
+ *          to cout or records telemetry they run one after another in
+ *          partition order instead, so lines and records stay in order
+ *
+ * @param in: network
+ *            Network of all base stations
+ *
+ *            minutes
+ *            Number of minutes to simulate
+ *
+ * @return void
+ *
+ * @note None
+ */
+void networkAdvance( BaseNetwork& network, const int minutes )
+{
+    int count = network.partitions.size();
+    int parts = max( 1, min( network.workers, count ) );
+    int base;
+
+    for( base = 0; base < count; base++ )
+    {
+        if( network.partitions[base].console
+             || network.partitions[base].telemetry != NULL )
+        {
+            parts = 1;
+        }
+    }
+
+    parallelFor( network.workerPool, count, parts,
+                 [&]( int, int begin, int end )
+    {
+        int member;
+
+        for( member = begin; member < end; member++ )
+        {
+            advanceTime( network.partitions[member], minutes );
+        }
+    } );
+}
+
+/**
+ * @brief Sends a batch of packets through whichever partitions they enter
+ *
+ * @details Each packet is routed with networkRoute, then every partition
+ *          sends the packets routed to it with sendPacketBatch. Packets
+ *          with no Drone in flight anywhere are dropped. Results add up in
+ *          one batch
+ *
+ * @param in: network
+ *            Network of all base stations
+ *
+ *            xPos
+ *            x coordinates the packets are sent from
+ *
+ *            yPos
+ *            y coordinates the packets are sent from
+ *
+ *            count
+ *            Number of packets
+ *
+ *            batch
+ *            Scratch space, and counters the results are added to
+ *
+ * @return void
+ *
+ * @note O(count * partitions * findClosest) on top of sendPacketBatch
+ */
+void networkSendBatch( BaseNetwork& network, const int* xPos, const int* yPos,
+                       int count, PacketBatch& batch )
+{
+    int packet, base;
+
+    batch.route.resize( count );
+    for( packet = 0; packet < count; packet++ )
+    {
+        batch.route[packet] = networkRoute( network, xPos[packet], yPos[packet] );
+        if( batch.route[packet] < 0 )
+        {
+            batch.dropped++;
+        }
+    }
+
+    for( base = 0; base < (int)network.partitions.size(); base++ )
+    {
+        batch.sourceXPos.clear();
+        batch.sourceYPos.clear();
+        for( packet = 0; packet < count; packet++ )
+        {
+            if( batch.route[packet] == base )
+            {
+                batch.sourceXPos.push_back( xPos[packet] );
+                batch.sourceYPos.push_back( yPos[packet] );
+            }
+        }
+
+        if( !batch.sourceXPos.empty() )
+        {
+            sendPacketBatch( network.partitions[base], batch.sourceXPos.data(),
+                             batch.sourceYPos.data(), batch.sourceXPos.size(),
+                             batch );
+        }
+    }
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
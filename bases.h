@@ -0,0 +1,41 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file bases.h
+ *
+ * @details Header file for the base station network which provides
+ *          prototypes for running one Fleet partition per Command and
+ *          Control Center
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef BASES_H
+#define BASES_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+void networkClear( BaseNetwork& network );
+void networkFreeDisasters( BaseNetwork& network,
+                          const vector<Disaster>& disasterSet );
+void networkReserve( BaseNetwork& network, vector<Disaster>& disasterSet,
+                     int drones, int disasters );
+void networkAddBase( BaseNetwork& network, int xPos, int yPos, int drones,
+                     int reserve, uint64_t seed );
+int networkCheapest( BaseNetwork& network, int xPos, int yPos );
+int networkRoute( const BaseNetwork& network, int xPos, int yPos );
+void networkAdvance( BaseNetwork& network, const int minutes );
+void networkSendBatch( BaseNetwork& network, const int* xPos, const int* yPos,
+                       int count, PacketBatch& batch );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
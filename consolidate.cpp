@@ -0,0 +1,346 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file consolidate.cpp
+ *
+ * @details Implementation file for the relay consolidation pass which
+ *          provides function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef CONSOLIDATE_CPP
+#define CONSOLIDATE_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "consolidate.h"
+#include "instrument.h"
+#include "idlequeue.h"
+#include "spatialgrid.h"
+#include "relays.h"
+#include "planner.h"
+#include "telemetry.h"
+#include "simulator.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Collects the Drones of a relay that nothing else hangs off
+ *
+ * @details The relay is walked from its tail back to its head. It can only
+ *          be planned again if it still forms a single chain and no Drone
+ *          of another relay attaches to one of its Drones, since moving the
+ *          relay would cut that Drone off from the base. Children are within
+ *          range of their previous Drone, so a grid query per Drone finds
+ *          them
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            disNum
+ *            Disaster number of the relay
+ *
+ *            members
+ *            Filled with the Drones of the relay, tail first
+ *
+ *            nearby
+ *            Scratch space for the grid queries
+ *
+ * @return bool True if the relay can be planned again
+ *
+ * @note O(relay length * nearby)
+ */
+static bool relayMembers( const Fleet& fleet, int disNum, vector<int>& members,
+                          vector<int>& nearby )
+{
+    int index = fleet.relays[disNum].tail;
+    int member, other;
+
+    members.clear();
+    while( index >= 0 && fleet.disNum[index] == disNum
+            && (int)members.size() < fleet.relays[disNum].length )
+    {
+        members.push_back( index );
+        index = fleet.previous[index];
+    }
+
+    if( members.empty() || (int)members.size() != fleet.relays[disNum].length
+         || members.back() != fleet.relays[disNum].head )
+    {
+        return false;
+    }
+
+    for( member = 0; member < (int)members.size(); member++ )
+    {
+        index = members[member];
+        gridWithinRadius( fleet, fleet.xPos[index], fleet.yPos[index],
+                          fleet.range, nearby );
+
+        for( other = 0; other < (int)nearby.size(); other++ )
+        {
+            if( fleet.previous[nearby[other]] == index
+                 && fleet.disNum[nearby[other]] != disNum )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Decides whether a point is in reach of the Drones left in the grid
+ *        or of a planned position
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            xPos
+ *            x coordinate of the point
+ *
+ *            yPos
+ *            y coordinate of the point
+ *
+ *            plan
+ *            Positions about to be taken
+ *
+ * @return bool True if the point is covered
+ *
+ * @note O(gridNearest + planned Drones)
+ */
+static bool pointCovered( const Fleet& fleet, int xPos, int yPos,
+                          const RelayPlan& plan )
+{
+    int nearest = gridNearest( fleet, xPos, yPos );
+    int step;
+
+    if( nearest >= 0 && inReach( fleet, fleet.xPos[nearest],
+                                 fleet.yPos[nearest], xPos, yPos ) )
+    {
+        return true;
+    }
+
+    for( step = 0; step < (int)plan.xPos.size(); step++ )
+    {
+        if( inReach( fleet, plan.xPos[step], plan.yPos[step], xPos, yPos ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Plans a relay again against the rest of the network and keeps the
+ *        new plan if it needs fewer Drones
+ *
+ * @details The relay's Drones are lifted out of the grid and planRelay is
+ *          asked for the cheapest way to reach the Disaster from what is
+ *          left, which may be a Drone of a relay built after this one. A
+ *          Disaster another Drone already reaches needs no relay at all. The
+ *          plan is only taken if it saves a Drone and every other Disaster
+ *          the relay covered stays covered. The highest battery Drones of
+ *          the relay are moved to the planned positions and the others land
+ *
+ * @param in: fleet
+ *            Fleet of all Drones, batteries current
+ *
+ *            disNum
+ *            Disaster number of the relay
+ *
+ *            members
+ *            Drones of the relay, see relayMembers
+ *
+ *            plan
+ *            Scratch space for the new plan
+ *
+ * @return int number of Drones that landed
+ *
+ * @note O(planRelay + disasters * gridNearest)
+ */
+static int replanRelay( Fleet& fleet, int disNum, vector<int>& members,
+                        RelayPlan& plan )
+{
+    int xPos = fleet.relays[disNum].xPos;
+    int yPos = fleet.relays[disNum].yPos;
+    int nearest, member, step, other, index, prevDrone;
+    bool planned = true;
+    bool keep;
+
+    for( member = 0; member < (int)members.size(); member++ )
+    {
+        gridRemove( fleet, members[member] );
+    }
+
+    nearest = gridNearest( fleet, xPos, yPos );
+    if( nearest >= 0 && inReach( fleet, fleet.xPos[nearest],
+                                 fleet.yPos[nearest], xPos, yPos ) )
+    {
+        plan.attach = -1;
+        plan.xPos.clear();
+        plan.yPos.clear();
+    }
+    else
+    {
+        planned = planRelay( fleet, xPos, yPos, plan );
+    }
+
+    keep = planned && plan.xPos.size() < members.size();
+
+    //Disasters covered by the relay without one of their own
+    for( other = 0; other < (int)fleet.relays.size() && keep; other++ )
+    {
+        if( other == disNum || fleet.relays[other].xPos < 0
+             || pointCovered( fleet, fleet.relays[other].xPos,
+                              fleet.relays[other].yPos, plan ) )
+        {
+            continue;
+        }
+
+        for( member = 0; member < (int)members.size() && keep; member++ )
+        {
+            keep = !inReach( fleet, fleet.xPos[members[member]],
+                             fleet.yPos[members[member]],
+                             fleet.relays[other].xPos,
+                             fleet.relays[other].yPos );
+        }
+    }
+
+    if( !keep )
+    {
+        for( member = 0; member < (int)members.size(); member++ )
+        {
+            gridInsert( fleet, members[member] );
+        }
+
+        return 0;
+    }
+
+    sort( members.begin(), members.end(), [&]( int first, int second )
+    {
+        return fleet.battery[first] > fleet.battery[second]
+               || ( fleet.battery[first] == fleet.battery[second]
+                    && first < second );
+    } );
+
+    relayReset( fleet, disNum );
+    fleet.relays[disNum].xPos = xPos;
+    fleet.relays[disNum].yPos = yPos;
+    if( plan.xPos.empty() )
+    {
+        relayShare( fleet, disNum );
+    }
+
+    prevDrone = plan.attach;
+    for( step = 0; step < (int)plan.xPos.size(); step++ )
+    {
+        index = members[step];
+        fleet.xPos[index] = plan.xPos[step];
+        fleet.yPos[index] = plan.yPos[step];
+        fleet.previous[index] = prevDrone;
+        fleet.next[index] = -1;
+        fleet.firstDrone[index] = step == 0;
+        if( step > 0 )
+        {
+            fleet.next[prevDrone] = index;
+        }
+        gridInsert( fleet, index );
+        relayAppend( fleet, disNum, index );
+        logEvent( fleet, EVENT_DISPATCHED, index, disNum, plan.xPos[step],
+                  plan.yPos[step] );
+        prevDrone = index;
+    }
+
+    for( member = plan.xPos.size(); member < (int)members.size(); member++ )
+    {
+        index = members[member];
+        logEvent( fleet, EVENT_RELAY_CONSOLIDATED, index, disNum,
+                  fleet.xPos[index], fleet.yPos[index] );
+        fleet.inFlight[index] = false;
+        fleet.dronesUsed--;
+        fleet.xPos[index] = fleet.baseX;
+        fleet.yPos[index] = fleet.baseY;
+        fleet.disNum[index] = -1;
+        fleet.firstDrone[index] = false;
+        fleet.previous[index] = -1;
+        fleet.next[index] = -1;
+        idleInsert( fleet, index );
+    }
+
+    return members.size() - plan.xPos.size();
+}
+
+/**
+ * @brief Merges relays onto a shared backbone and lands the Drones that are
+ *        no longer needed
+ *
+ * @details generateRelay only attaches a new relay to the Drones that exist
+ *          when its Disaster appears, so a relay built early never benefits
+ *          from the ones built after it. This pass plans every relay again,
+ *          in Disaster order, against the rest of the network with
+ *          replanRelay. Each relay is cut in as a branch at whatever Drone
+ *          needs the fewest new Drones, the greedy Steiner tree heuristic,
+ *          so over repeated passes parallel and overlapping relays fold into
+ *          one backbone. The Drone count only ever goes down, so relays
+ *          never move back and forth between passes
+ *
+ * @param in: fleet
+ *            Fleet of all Drones, batteries current
+ *
+ *            currentTime
+ *            Needed for reference when printing consolidation information
+ *
+ * @return int number of Drones that landed
+ *
+ * @note O(relays * ( relay length * nearby + planRelay + disasters *
+ *       gridNearest ))
+ */
+int consolidateRelays( Fleet& fleet, const int currentTime )
+{
+    INSTRUMENT_SCOPE( PROBE_CONSOLIDATE_RELAYS );
+    vector<int>& members = fleet.scratch.members;
+    RelayPlan& plan = fleet.scratch.plan;
+    int disNum;
+    int landed = 0;
+
+    for( disNum = 0; disNum < (int)fleet.relays.size(); disNum++ )
+    {
+        if( fleet.relays[disNum].xPos >= 0
+             && relayMembers( fleet, disNum, members,
+                              fleet.scratch.nearby ) )
+        {
+            INSTRUMENT_SCANNED( PROBE_CONSOLIDATE_RELAYS, members.size() );
+            landed += replanRelay( fleet, disNum, members, plan );
+        }
+    }
+
+    fleet.consolidated += landed;
+
+    if( fleet.console && landed > 0 )
+    {
+        cout << "Relays consolidated, " << landed
+             << ( landed == 1 ? " drone" : " drones" ) << " returned to base";
+
+        if( currentTime >= 0 )
+        {
+            cout << " at time " << currentTime;
+        }
+
+        cout << '\n';
+    }
+
+    return landed;
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,30 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file consolidate.h
+ *
+ * @details Header file for the relay consolidation pass which provides
+ *          prototypes for merging relays onto a shared backbone and
+ *          returning the Drones it frees to the base station
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef CONSOLIDATE_H
+#define CONSOLIDATE_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+int consolidateRelays( Fleet& fleet, const int currentTime );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,267 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file eventengine.cpp
+ *
+ * @details Implementation file for the discrete event engine which provides
+ *          function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef EVENTENGINE_CPP
+#define EVENTENGINE_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include "eventengine.h"
+#include "instrument.h"
+#include "idlequeue.h"
+#include "repair.h"
+#include "consolidate.h"
+#include "telemetry.h"
+#include "simulator.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Returns the clock value at which an in flight Drone first drops
+ *        below the replacement threshold
+ *
+ * @details In flight Drones lose 1% each minute, so a Drone with the given
+ *          battery at clock now is replaced after battery - lowBattery + 1
+ *          minutes, and never sooner than the next minute
+ *
+ * @param in: battery
+ *            Battery of the Drone at clock now
+ *
+ *            lowBattery
+ *            Replacement threshold of the Fleet
+ *
+ *            now
+ *            Current clock value
+ *
+ * @return int clock value of the replacement event
+ *
+ * @note None
+ */
+static int replacementTime( int battery, int lowBattery, int now )
+{
+    return now + max( 1, battery - lowBattery + 1 );
+}
+
+/**
+ * @brief Adds a replacement event to the queue
+ *
+ * @param in: events
+ *            Queue of replacement events
+ *
+ *            time
+ *            Clock value of the event
+ *
+ *            index
+ *            Drone to replace
+ *
+ * @return void
+ *
+ * @note O(log events)
+ */
+static void eventPush( EventQueue& events, int time, int index )
+{
+    events.push_back( make_pair( time, index ) );
+    push_heap( events.begin(), events.end(), greater< pair<int, int> >() );
+}
+
+/**
+ * @brief Removes the earliest event, found at events.front(), from the queue
+ *
+ * @param in: events
+ *            Queue of replacement events, not empty
+ *
+ * @return void
+ *
+ * @note O(log events)
+ */
+static void eventPop( EventQueue& events )
+{
+    pop_heap( events.begin(), events.end(), greater< pair<int, int> >() );
+    events.pop_back();
+}
+
+/**
+ * @brief Brings the battery of every in flight Drone up to date
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            flightKey
+ *            Battery plus clock at take off of every in flight Drone
+ *
+ *            now
+ *            Current clock value
+ *
+ * @return void
+ *
+ * @note O(airborne)
+ */
+static void syncFlightBatteries( Fleet& fleet, const vector<int>& flightKey,
+                                 int now )
+{
+    int cell, member, index;
+
+    for( cell = 0; cell < (int)fleet.airborne.cells.size(); cell++ )
+    {
+        for( member = 0; member < (int)fleet.airborne.cells[cell].drones.size();
+                                                                    member++ )
+        {
+            index = fleet.airborne.cells[cell].drones[member];
+            fleet.battery[index] = flightKey[index] - now;
+        }
+    }
+}
+
+/**
+ * @brief Simulates the given number of minutes by jumping from one Drone
+ *        replacement to the next
+ *
+ * @details Battery drain and charge are linear, so the only moments that
+ *          change the relays are the minutes an in flight Drone drops below
+ *          fleet.lowBattery. Each in flight Drone gets a replacement event in a
+ *          time ordered queue and the clock jumps straight to the next one.
+ *          Idle batteries are tracked by the idle queue's charge keys, and
+ *          in flight batteries by a flight key (battery plus clock at take
+ *          off), so no Drone is touched between events. Events at the same
+ *          minute run in index order, which gives the same replacements and
+ *          output as calling updateBatteries once per minute. A Drone that
+ *          can neither be replaced nor repaired around is tried again the
+ *          next minute. With fleet.consolidateEvery set, consolidateRelays
+ *          runs on every multiple of it after the events of that minute.
+ *          Drones it moves keep their battery, so their events stand. The
+ *          queue and flight keys are kept in the Fleet's scratch space, so
+ *          once they have grown advancing time does not allocate
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            minutes
+ *            Number of minutes to simulate
+ *
+ * @return void
+ *
+ * @note O(airborne + charging + events * log n), Drones that are fully
+ *       charged or lost are not touched
+ */
+void advanceTime( Fleet& fleet, const int minutes )
+{
+    INSTRUMENT_SCOPE( PROBE_ADVANCE_TIME );
+    const int startTime = fleet.clock;
+    const int endTime = startTime + minutes;
+    vector<int>& flightKey = fleet.scratch.flightKey;
+    vector<int>& due = fleet.scratch.due;
+    EventQueue& events = fleet.scratch.events;
+    int cell, member, index, newIndex, now;
+    int nextPass = endTime + 1;
+
+    //due is set before every push, so entries left by earlier calls are
+    //never read and the arrays need no clearing
+    flightKey.resize( fleet.size );
+    due.resize( fleet.size );
+    events.clear();
+
+    if( fleet.consolidateEvery > 0 )
+    {
+        nextPass = ( startTime / fleet.consolidateEvery + 1 )
+                   * fleet.consolidateEvery;
+    }
+
+    //schedule every Drone already in the air
+    for( cell = 0; cell < (int)fleet.airborne.cells.size(); cell++ )
+    {
+        for( member = 0; member < (int)fleet.airborne.cells[cell].drones.size();
+                                                                    member++ )
+        {
+            index = fleet.airborne.cells[cell].drones[member];
+            flightKey[index] = fleet.battery[index] + startTime;
+            due[index] = replacementTime( fleet.battery[index], fleet.lowBattery,
+                                          startTime );
+            eventPush( events, due[index], index );
+        }
+    }
+
+    while( ( !events.empty() && events.front().first <= endTime )
+            || nextPass <= endTime )
+    {
+        if( nextPass <= endTime
+             && ( events.empty() || events.front().first > nextPass ) )
+        {
+            fleet.clock = nextPass;
+            syncFlightBatteries( fleet, flightKey, nextPass );
+            consolidateRelays( fleet, nextPass - startTime - 1 );
+            nextPass += fleet.consolidateEvery;
+            continue;
+        }
+
+        now = events.front().first;
+        index = events.front().second;
+        eventPop( events );
+        INSTRUMENT_SCANNED( PROBE_ADVANCE_TIME, 1 );
+
+        if( !fleet.inFlight[index] || due[index] != now )
+        {
+            continue;
+        }
+
+        fleet.clock = now;
+        fleet.battery[index] = flightKey[index] - now;
+        newIndex = highestPower( fleet );
+
+        if( replaceDrone( index, fleet, now - startTime - 1 ) )
+        {
+            flightKey[newIndex] = fleet.battery[newIndex] + now;
+            due[newIndex] = replacementTime( fleet.battery[newIndex],
+                                             fleet.lowBattery, now );
+            eventPush( events, due[newIndex], newIndex );
+        }
+        else if( !repairRelay( index, fleet, now - startTime - 1 ) )
+        {
+            logEvent( fleet, EVENT_REPLACE_FAILED, index, -1, -1, -1 );
+            if( fleet.console )
+            {
+                cout << "No drones available to replace drone #" << index << '\n';
+            }
+            due[index] = now + 1;
+            eventPush( events, due[index], index );
+        }
+    }
+
+    //bring every battery up to date for the end of the run, charged Drones
+    //already hold 100 and lost Drones stay empty
+    fleet.clock = endTime;
+    idleSettle( fleet );
+    for( cell = 0; cell < (int)fleet.airborne.cells.size(); cell++ )
+    {
+        for( member = 0; member < (int)fleet.airborne.cells[cell].drones.size();
+                                                                    member++ )
+        {
+            index = fleet.airborne.cells[cell].drones[member];
+            fleet.battery[index] = flightKey[index] - endTime;
+        }
+    }
+
+    for( member = 0; member < (int)fleet.idle.charging.nodes.size(); member++ )
+    {
+        index = fleet.idle.charging.nodes[member];
+        fleet.battery[index] = min( 100, fleet.idle.chargeKey[index]
+                                                    + 5 * endTime );
+    }
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,36 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file eventengine.h
+ *
+ * @details Header file for the discrete event engine which provides
+ *          prototypes for advancing simulated time event by event
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef EVENTENGINE_H
+#define EVENTENGINE_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <utility>
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Type Definitions ///////////////////////////////////////////////////////////
+
+//(clock value, Drone index) pairs kept as a heap in the Fleet's scratch
+//space, earliest time then lowest index first
+typedef vector< pair<int, int> > EventQueue;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+void advanceTime( Fleet& fleet, const int minutes );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
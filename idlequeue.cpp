@@ -0,0 +1,443 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file idlequeue.cpp
+ *
+ * @details Implementation file for the idle Drone queue which provides
+ *          function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef IDLEQUEUE_CPP
+#define IDLEQUEUE_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <vector>
+#include "idlequeue.h"
+#include "pool.h"
+#include "instrument.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Decides which of two Drones belongs closer to the top of a heap
+ *
+ * @details Higher keys come first. Equal keys, or a heap without keys, fall
+ *          back to the lower Drone index
+ *
+ * @param in: key
+ *            Key array indexed by Drone, or NULL to order by index only
+ *
+ *            first
+ *            Index of the first Drone
+ *
+ *            second
+ *            Index of the second Drone
+ *
+ * @return bool True if first belongs above second
+ *
+ * @note None
+ */
+static bool heapBefore( const vector<int>* key, int first, int second )
+{
+    if( key != NULL && (*key)[first] != (*key)[second] )
+    {
+        return (*key)[first] > (*key)[second];
+    }
+
+    return first < second;
+}
+
+/**
+ * @brief Moves the Drone in the given heap slot up until its parent comes
+ *        before it
+ *
+ * @details Keeps the position array in sync with every move
+ *
+ * @param in: heap
+ *            Heap to fix
+ *
+ *            key
+ *            Key array indexed by Drone, or NULL to order by index only
+ *
+ *            slot
+ *            Heap slot of the Drone to move
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void heapSiftUp( DroneHeap& heap, const vector<int>* key, int slot )
+{
+    int index = heap.nodes[slot];
+    int parent;
+
+    while( slot > 0 )
+    {
+        parent = (slot - 1) / 2;
+        if( !heapBefore( key, index, heap.nodes[parent] ) )
+        {
+            break;
+        }
+        heap.nodes[slot] = heap.nodes[parent];
+        heap.position[heap.nodes[slot]] = slot;
+        slot = parent;
+    }
+
+    heap.nodes[slot] = index;
+    heap.position[index] = slot;
+}
+
+/**
+ * @brief Moves the Drone in the given heap slot down until both children
+ *        come after it
+ *
+ * @details Keeps the position array in sync with every move
+ *
+ * @param in: heap
+ *            Heap to fix
+ *
+ *            key
+ *            Key array indexed by Drone, or NULL to order by index only
+ *
+ *            slot
+ *            Heap slot of the Drone to move
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void heapSiftDown( DroneHeap& heap, const vector<int>* key, int slot )
+{
+    int count = heap.nodes.size();
+    int index = heap.nodes[slot];
+    int child;
+
+    while( (child = 2 * slot + 1) < count )
+    {
+        if( child + 1 < count
+            && heapBefore( key, heap.nodes[child + 1], heap.nodes[child] ) )
+        {
+            child++;
+        }
+        if( !heapBefore( key, heap.nodes[child], index ) )
+        {
+            break;
+        }
+        heap.nodes[slot] = heap.nodes[child];
+        heap.position[heap.nodes[slot]] = slot;
+        slot = child;
+    }
+
+    heap.nodes[slot] = index;
+    heap.position[index] = slot;
+}
+
+/**
+ * @brief Fills a heap with the given Drones in O(n)
+ *
+ * @details Any previous contents of the heap are discarded
+ *
+ * @param in: heap
+ *            Heap to build
+ *
+ *            key
+ *            Key array indexed by Drone, or NULL to order by index only
+ *
+ *            fleetSize
+ *            Number of Drones in the Fleet, used to size the position array
+ *
+ *            members
+ *            Indices of the Drones to place in the heap
+ *
+ * @return void
+ *
+ * @note None
+ */
+void heapBuild( DroneHeap& heap, const vector<int>* key, int fleetSize,
+                                            const vector<int>& members )
+{
+    int slot;
+
+    heap.nodes = members;
+    heap.position.assign( fleetSize, -1 );
+
+    for( slot = 0; slot < (int)heap.nodes.size(); slot++ )
+    {
+        heap.position[heap.nodes[slot]] = slot;
+    }
+
+    for( slot = (int)heap.nodes.size() / 2 - 1; slot >= 0; slot-- )
+    {
+        heapSiftDown( heap, key, slot );
+    }
+}
+
+/**
+ * @brief Adds a Drone to a heap
+ *
+ * @details O(log n)
+ *
+ * @param in: heap
+ *            Heap to add to
+ *
+ *            key
+ *            Key array indexed by Drone, or NULL to order by index only
+ *
+ *            index
+ *            Index of the Drone to add
+ *
+ * @return void
+ *
+ * @note The Drone must not already be in the heap
+ */
+void heapPush( DroneHeap& heap, const vector<int>* key, int index )
+{
+    heap.nodes.push_back( index );
+    heapSiftUp( heap, key, heap.nodes.size() - 1 );
+}
+
+/**
+ * @brief Removes a Drone from a heap if it is in it
+ *
+ * @details The last Drone in the heap takes the freed slot and is sifted
+ *          whichever way restores the heap order. O(log n)
+ *
+ * @param in: heap
+ *            Heap to remove from
+ *
+ *            key
+ *            Key array indexed by Drone, or NULL to order by index only
+ *
+ *            index
+ *            Index of the Drone to remove
+ *
+ * @return bool Evidence that the Drone was in the heap
+ *
+ * @note None
+ */
+bool heapRemove( DroneHeap& heap, const vector<int>* key, int index )
+{
+    int slot = heap.position[index];
+    int last;
+
+    if( slot < 0 )
+    {
+        return false;
+    }
+
+    heap.position[index] = -1;
+    last = heap.nodes.back();
+    heap.nodes.pop_back();
+
+    if( last != index )
+    {
+        heap.nodes[slot] = last;
+        heap.position[last] = slot;
+        if( slot > 0 && heapBefore( key, last, heap.nodes[(slot - 1) / 2] ) )
+        {
+            heapSiftUp( heap, key, slot );
+        }
+        else
+        {
+            heapSiftDown( heap, key, slot );
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Returns the Drone at the top of a heap
+ *
+ * @details O(1)
+ *
+ * @param in: heap
+ *            Heap to look at
+ *
+ * @return int index of the top Drone, -1 if the heap is empty
+ *
+ * @note None
+ */
+int heapTop( const DroneHeap& heap )
+{
+    if( heap.nodes.empty() )
+    {
+        return -1;
+    }
+
+    return heap.nodes[0];
+}
+
+/**
+ * @brief Rebuilds the idle queue from the battery and inFlight arrays
+ *
+ * @details Every Drone in service that is not in flight gets a charge key
+ *          for the current clock and is placed in the charging or charged
+ *          heap. Lost Drones stay out of both
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ * @return void
+ *
+ * @note Used after generateFleet, O(n)
+ */
+void idleBuild( Fleet& fleet )
+{
+    int index;
+    vector<int> charging, charged;
+
+    fleet.idle.chargeKey.assign( fleet.size, 0 );
+
+    for( index = 0; index < fleet.size; index++ )
+    {
+        if( !fleet.inFlight[index] && poolLive( fleet.drones, index ) )
+        {
+            fleet.idle.chargeKey[index] = fleet.battery[index] - 5 * fleet.clock;
+            if( fleet.battery[index] >= 100 )
+            {
+                charged.push_back( index );
+            }
+            else
+            {
+                charging.push_back( index );
+            }
+        }
+    }
+
+    heapBuild( fleet.idle.charging, &fleet.idle.chargeKey, fleet.size, charging );
+    heapBuild( fleet.idle.charged, NULL, fleet.size, charged );
+}
+
+/**
+ * @brief Adds a Drone that just landed to the idle queue
+ *
+ * @details The charge key is taken from the Drone's current battery and the
+ *          current clock. O(log n)
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            Index of the Drone that landed
+ *
+ * @return void
+ *
+ * @note None
+ */
+void idleInsert( Fleet& fleet, int index )
+{
+    fleet.idle.chargeKey[index] = fleet.battery[index] - 5 * fleet.clock;
+
+    if( fleet.battery[index] >= 100 )
+    {
+        heapPush( fleet.idle.charged, NULL, index );
+    }
+    else
+    {
+        heapPush( fleet.idle.charging, &fleet.idle.chargeKey, index );
+    }
+}
+
+/**
+ * @brief Removes a Drone that is taking off from the idle queue
+ *
+ * @details The Drone's battery is brought up to date from its charge key
+ *          first, since time may have advanced without touching the battery
+ *          array. O(log n)
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            Index of the Drone taking off
+ *
+ * @return void
+ *
+ * @note None
+ */
+void idleRemove( Fleet& fleet, int index )
+{
+    fleet.battery[index] = min( 100, fleet.idle.chargeKey[index] + 5 * fleet.clock );
+
+    if( !heapRemove( fleet.idle.charging, &fleet.idle.chargeKey, index ) )
+    {
+        heapRemove( fleet.idle.charged, NULL, index );
+    }
+}
+
+/**
+ * @brief Moves every Drone that has reached 100% from the charging heap to
+ *        the charged heap
+ *
+ * @details Their battery is set to 100 as they move, so the battery array
+ *          is current for every charged Drone. O(log n) per Drone moved
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ * @return void
+ *
+ * @note None
+ */
+void idleSettle( Fleet& fleet )
+{
+    int top = heapTop( fleet.idle.charging );
+
+    while( top >= 0 && fleet.idle.chargeKey[top] + 5 * fleet.clock >= 100 )
+    {
+        INSTRUMENT_SCANNED( PROBE_HIGHEST_POWER, 1 );
+        heapRemove( fleet.idle.charging, &fleet.idle.chargeKey, top );
+        heapPush( fleet.idle.charged, NULL, top );
+        fleet.battery[top] = 100;
+        top = heapTop( fleet.idle.charging );
+    }
+}
+
+/**
+ * @brief Returns the idle Drone with the most full battery
+ *
+ * @details Drones that reached 100% since the last call are first moved to
+ *          the charged heap, see idleSettle. Any fully charged Drone beats
+ *          every charging one, and ties go to the lowest index. O(log n)
+ *          amortized
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ * @return int index of highest battery idle Drone, -1 if none has charge
+ *
+ * @note None
+ */
+int idleBest( Fleet& fleet )
+{
+    INSTRUMENT_SCOPE( PROBE_HIGHEST_POWER );
+    INSTRUMENT_SCANNED( PROBE_HIGHEST_POWER, 1 );
+    int top;
+
+    idleSettle( fleet );
+    top = heapTop( fleet.idle.charging );
+
+    if( heapTop( fleet.idle.charged ) >= 0 )
+    {
+        return heapTop( fleet.idle.charged );
+    }
+
+    if( top >= 0 && fleet.idle.chargeKey[top] + 5 * fleet.clock > 0 )
+    {
+        return top;
+    }
+
+    return -1;
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
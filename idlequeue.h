@@ -0,0 +1,38 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file idlequeue.h
+ *
+ * @details Header file for the idle Drone queue which provides prototypes
+ *          for the indexed heap used by highestPower
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef IDLEQUEUE_H
+#define IDLEQUEUE_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+void heapBuild( DroneHeap& heap, const vector<int>* key, int fleetSize,
+                                            const vector<int>& members );
+void heapPush( DroneHeap& heap, const vector<int>* key, int index );
+bool heapRemove( DroneHeap& heap, const vector<int>* key, int index );
+int heapTop( const DroneHeap& heap );
+void idleBuild( Fleet& fleet );
+void idleInsert( Fleet& fleet, int index );
+void idleRemove( Fleet& fleet, int index );
+void idleSettle( Fleet& fleet );
+int idleBest( Fleet& fleet );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
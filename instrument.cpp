@@ -0,0 +1,430 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file instrument.cpp
+ *
+ * @details Implementation file for hot path instrumentation which provides
+ *          function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef INSTRUMENT_CPP
+#define INSTRUMENT_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+#include "instrument.h"
+
+using namespace std;
+
+// Struct Definitions /////////////////////////////////////////////////////////
+
+/**
+ * @brief ProbeCounters struct holds the counters of one probed function in
+ *        one thread
+ *
+ * @details Same fields as ProbeStats. Only the owning thread writes them,
+ *          so a relaxed load and store is enough to add to one, and a
+ *          report can read them from another thread while it runs
+ */
+struct ProbeCounters
+{
+    atomic<long> calls;
+    atomic<long> scanned;
+    atomic<long> totalNanos;
+    atomic<long> maxNanos;
+    atomic<long> histogram[HISTOGRAM_BUCKETS];
+};
+
+/**
+ * @brief ProbeThread struct holds the counters of one thread
+ *
+ * @details Each thread records into its own copy without locking. The
+ *          copies register themselves so a report can add them up, and fold
+ *          into the retired totals when their thread exits, as pool threads
+ *          do when their Fleet's pool is destroyed
+ */
+struct ProbeThread
+{
+    ProbeCounters stats[PROBE_COUNT];
+
+    ProbeThread();
+    ~ProbeThread();
+};
+
+// Global Variables ///////////////////////////////////////////////////////////
+
+static const char* const PROBE_NAMES[PROBE_COUNT] =
+{
+    "generateRelay", "findClosest", "highestPower", "replaceDrone",
+    "updateBatteries", "sendPacket", "consolidateRelays",
+    "pipelineStep", "advanceTime"
+};
+
+static mutex probeLock; //guards liveThreads and retiredStats
+static vector<ProbeThread*> liveThreads;
+static ProbeStats retiredStats[PROBE_COUNT];
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Adds one set of probe counters into another
+ *
+ * @param in: total
+ *            Counters to add to
+ *
+ *            stats
+ *            Counters to add
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void mergeStats( ProbeStats& total, const ProbeStats& stats )
+{
+    int bucket;
+
+    total.calls += stats.calls;
+    total.scanned += stats.scanned;
+    total.totalNanos += stats.totalNanos;
+    total.maxNanos = max( total.maxNanos, stats.maxNanos );
+
+    for( bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++ )
+    {
+        total.histogram[bucket] += stats.histogram[bucket];
+    }
+}
+
+/**
+ * @brief Adds a thread's live counters into a set of probe counters
+ *
+ * @details Each counter is read with a relaxed load, so a call being
+ *          recorded at the same time may be counted in some fields and not
+ *          yet in others
+ *
+ * @param in: total
+ *            Counters to add to
+ *
+ *            counters
+ *            Live counters to add
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void mergeCounters( ProbeStats& total, const ProbeCounters& counters )
+{
+    ProbeStats stats;
+    int bucket;
+
+    stats.calls = counters.calls.load( memory_order_relaxed );
+    stats.scanned = counters.scanned.load( memory_order_relaxed );
+    stats.totalNanos = counters.totalNanos.load( memory_order_relaxed );
+    stats.maxNanos = counters.maxNanos.load( memory_order_relaxed );
+
+    for( bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++ )
+    {
+        stats.histogram[bucket] =
+                counters.histogram[bucket].load( memory_order_relaxed );
+    }
+
+    mergeStats( total, stats );
+}
+
+/**
+ * @brief Sets a live counter of the calling thread
+ *
+ * @param in: counter
+ *            Counter owned by the calling thread
+ *
+ *            value
+ *            New value
+ *
+ * @return void
+ *
+ * @note A relaxed store, no other thread writes the counter
+ */
+static inline void setCounter( atomic<long>& counter, long value )
+{
+    counter.store( value, memory_order_relaxed );
+}
+
+/**
+ * @brief Adds to a live counter of the calling thread
+ *
+ * @param in: counter
+ *            Counter owned by the calling thread
+ *
+ *            amount
+ *            Amount to add
+ *
+ * @return void
+ *
+ * @note A relaxed load and store instead of an atomic add, since no other
+ *       thread writes the counter
+ */
+static inline void addCounter( atomic<long>& counter, long amount )
+{
+    setCounter( counter, counter.load( memory_order_relaxed ) + amount );
+}
+
+ProbeThread::ProbeThread()
+{
+    int probe, bucket;
+
+    for( probe = 0; probe < PROBE_COUNT; probe++ )
+    {
+        setCounter( stats[probe].calls, 0 );
+        setCounter( stats[probe].scanned, 0 );
+        setCounter( stats[probe].totalNanos, 0 );
+        setCounter( stats[probe].maxNanos, 0 );
+        for( bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++ )
+        {
+            setCounter( stats[probe].histogram[bucket], 0 );
+        }
+    }
+
+    lock_guard<mutex> guard( probeLock );
+    liveThreads.push_back( this );
+}
+
+ProbeThread::~ProbeThread()
+{
+    int probe;
+
+    lock_guard<mutex> guard( probeLock );
+    for( probe = 0; probe < PROBE_COUNT; probe++ )
+    {
+        mergeCounters( retiredStats[probe], stats[probe] );
+    }
+    liveThreads.erase( find( liveThreads.begin(), liveThreads.end(), this ) );
+}
+
+/**
+ * @brief Returns the counters of the calling thread, creating them on its
+ *        first call
+ *
+ * @return ProbeThread& counters of the calling thread
+ *
+ * @note None
+ */
+static ProbeThread& probeThread()
+{
+    thread_local ProbeThread local;
+
+    return local;
+}
+
+/**
+ * @brief Returns the histogram bucket of a latency
+ *
+ * @param in: nanos
+ *            Latency in nanoseconds
+ *
+ * @return int bucket index
+ *
+ * @note None
+ */
+static int histogramBucket( long nanos )
+{
+    int exponent = 0;
+
+    if( nanos < HISTOGRAM_LINEAR )
+    {
+        return max( 0L, nanos );
+    }
+
+    while( ( nanos >> ( exponent + 1 ) ) > 0 )
+    {
+        exponent++;
+    }
+
+    //exponent is at least 4, the top 3 bits below the leading one pick the
+    //sub bucket
+    return min( HISTOGRAM_BUCKETS - 1,
+                HISTOGRAM_LINEAR + ( exponent - 4 ) * HISTOGRAM_SUB_BUCKETS
+                    + (int)( ( nanos >> ( exponent - 3 ) ) & 7 ) );
+}
+
+#ifdef SIM_INSTRUMENT
+
+/**
+ * @brief Returns the largest latency that falls in a histogram bucket
+ *
+ * @param in: bucket
+ *            bucket index
+ *
+ * @return long latency in nanoseconds
+ *
+ * @note None
+ */
+static long bucketLimit( int bucket )
+{
+    int exponent, sub;
+
+    if( bucket < HISTOGRAM_LINEAR )
+    {
+        return bucket;
+    }
+
+    exponent = ( bucket - HISTOGRAM_LINEAR ) / HISTOGRAM_SUB_BUCKETS + 4;
+    sub = ( bucket - HISTOGRAM_LINEAR ) % HISTOGRAM_SUB_BUCKETS;
+
+    return ( ( 8L + sub + 1 ) << ( exponent - 3 ) ) - 1;
+}
+
+/**
+ * @brief Returns the latency under which a fraction of the calls finished
+ *
+ * @param in: stats
+ *            Counters of one probe
+ *
+ *            fraction
+ *            Fraction of calls, .99 for the 99th percentile
+ *
+ * @return long latency in nanoseconds, never above the largest seen
+ *
+ * @note None
+ */
+static long percentile( const ProbeStats& stats, double fraction )
+{
+    long wanted = (long)( fraction * stats.calls + .999999 );
+    long seen = 0;
+    int bucket;
+
+    for( bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++ )
+    {
+        seen += stats.histogram[bucket];
+        if( seen >= wanted )
+        {
+            break;
+        }
+    }
+
+    return min( bucketLimit( bucket ), stats.maxNanos );
+}
+
+#endif
+
+/**
+ * @brief Records one call of a probed function in the calling thread
+ *
+ * @param in: probe
+ *            One of the PROBE_ constants
+ *
+ *            nanos
+ *            Time the call took
+ *
+ * @return void
+ *
+ * @note Called by ProbeTimer
+ */
+void probeRecord( int probe, long nanos )
+{
+    ProbeCounters& stats = probeThread().stats[probe];
+
+    addCounter( stats.calls, 1 );
+    addCounter( stats.totalNanos, nanos );
+    setCounter( stats.maxNanos, max( stats.maxNanos.load( memory_order_relaxed ),
+                                     nanos ) );
+    addCounter( stats.histogram[histogramBucket( nanos )], 1 );
+}
+
+/**
+ * @brief Adds Drones examined by a probed function in the calling thread
+ *
+ * @param in: probe
+ *            One of the PROBE_ constants
+ *
+ *            count
+ *            Number of Drones examined
+ *
+ * @return void
+ *
+ * @note None
+ */
+void probeScanned( int probe, long count )
+{
+    addCounter( probeThread().stats[probe].scanned, count );
+}
+
+/**
+ * @brief Prints calls, Drones scanned per call and latency percentiles for
+ *        every probed function, summed over all threads
+ *
+ * @param in: out
+ *            Stream to print to
+ *
+ * @return void
+ *
+ * @note Safe while worker threads are recording, calls still in progress
+ *       may be missed
+ */
+void instrumentReport( ostream& out )
+{
+#ifdef SIM_INSTRUMENT
+    ProbeStats totals[PROBE_COUNT];
+    ios::fmtflags flags = out.flags();
+    int probe, thread;
+
+    memset( totals, 0, sizeof( totals ) );
+    probeThread(); //so an idle main thread still reports
+
+    {
+        lock_guard<mutex> guard( probeLock );
+        for( probe = 0; probe < PROBE_COUNT; probe++ )
+        {
+            mergeStats( totals[probe], retiredStats[probe] );
+            for( thread = 0; thread < (int)liveThreads.size(); thread++ )
+            {
+                mergeCounters( totals[probe], liveThreads[thread]->stats[probe] );
+            }
+        }
+    }
+
+    out << '\n' << left << setw( 17 ) << "function" << right
+        << setw( 12 ) << "calls" << setw( 14 ) << "scanned/call"
+        << setw( 11 ) << "mean ns" << setw( 10 ) << "p50 ns"
+        << setw( 10 ) << "p90 ns" << setw( 10 ) << "p99 ns"
+        << setw( 12 ) << "max ns" << '\n';
+
+    for( probe = 0; probe < PROBE_COUNT; probe++ )
+    {
+        const ProbeStats& stats = totals[probe];
+
+        out << left << setw( 17 ) << PROBE_NAMES[probe] << right
+            << setw( 12 ) << stats.calls;
+
+        if( stats.calls > 0 )
+        {
+            out << setw( 14 ) << fixed << setprecision( 1 )
+                << (double)stats.scanned / stats.calls
+                << setw( 11 ) << stats.totalNanos / stats.calls
+                << setw( 10 ) << percentile( stats, .5 )
+                << setw( 10 ) << percentile( stats, .9 )
+                << setw( 10 ) << percentile( stats, .99 )
+                << setw( 12 ) << stats.maxNanos;
+        }
+
+        out << '\n';
+    }
+
+    out.flags( flags );
+#else
+    out << '\n' << "Instrumentation is compiled out, build with make instrument"
+        << '\n';
+#endif
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
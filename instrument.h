@@ -0,0 +1,103 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file instrument.h
+ *
+ * @details Header file for hot path instrumentation which provides per
+ *          thread call counters and latency histograms. Compiled out unless
+ *          SIM_INSTRUMENT is defined (make instrument)
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+// Global Constants ///////////////////////////////////////////////////////////
+
+//probed functions
+static const int PROBE_GENERATE_RELAY = 0;
+static const int PROBE_FIND_CLOSEST = 1;
+static const int PROBE_HIGHEST_POWER = 2;
+static const int PROBE_REPLACE_DRONE = 3;
+static const int PROBE_UPDATE_BATTERIES = 4;
+static const int PROBE_SEND_PACKET = 5;
+static const int PROBE_CONSOLIDATE_RELAYS = 6;
+static const int PROBE_PIPELINE_STEP = 7;
+static const int PROBE_ADVANCE_TIME = 8;
+static const int PROBE_COUNT = 9;
+
+//latencies below 16ns get a bucket each, then 8 buckets per power of two
+static const int HISTOGRAM_LINEAR = 16;
+static const int HISTOGRAM_SUB_BUCKETS = 8;
+static const int HISTOGRAM_BUCKETS = HISTOGRAM_LINEAR + 40 * HISTOGRAM_SUB_BUCKETS;
+
+// Struct Definitions /////////////////////////////////////////////////////////
+
+/**
+ * @brief ProbeStats struct holds the counters of one probed function
+ *
+ * @details histogram counts calls by latency, see HISTOGRAM_ constants, so
+ *          every percentile is accurate to within an eighth of its value
+ */
+struct ProbeStats
+{
+    long calls;
+    long scanned; //Drones or events examined
+    long totalNanos;
+    long maxNanos;
+    long histogram[HISTOGRAM_BUCKETS];
+};
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+void probeRecord( int probe, long nanos );
+void probeScanned( int probe, long count );
+void instrumentReport( ostream& out );
+
+// Class Definitions //////////////////////////////////////////////////////////
+
+/**
+ * @brief ProbeTimer times the scope it is declared in and records it under
+ *        its probe when the scope ends
+ */
+class ProbeTimer
+{
+    public:
+        explicit ProbeTimer( int probe )
+            : probe( probe ), start( chrono::steady_clock::now() )
+        {
+        }
+
+        ~ProbeTimer()
+        {
+            probeRecord( probe, chrono::duration_cast<chrono::nanoseconds>(
+                            chrono::steady_clock::now() - start ).count() );
+        }
+
+    private:
+        int probe;
+        chrono::steady_clock::time_point start;
+};
+
+// Macro Definitions //////////////////////////////////////////////////////////
+
+#ifdef SIM_INSTRUMENT
+#define INSTRUMENT_SCOPE( probe ) ProbeTimer probeTimer( probe )
+#define INSTRUMENT_SCANNED( probe, count ) probeScanned( probe, count )
+#else
+#define INSTRUMENT_SCOPE( probe )
+#define INSTRUMENT_SCANNED( probe, count )
+#endif
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
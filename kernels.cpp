@@ -0,0 +1,459 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file kernels.cpp
+ *
+ * @details Implementation file for the vectorized kernels which provides
+ *          function definitions and documentation
+ *
+ * @Note Every kernel produces exactly the same results as its scalar
+ *       version, only the speed differs
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef KERNELS_CPP
+#define KERNELS_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <vector>
+#include "kernels.h"
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <immintrin.h>
+#define KERNELS_X86
+#endif
+
+using namespace std;
+
+// Global Variables ///////////////////////////////////////////////////////////
+
+BatteryKernel batteryKernel = batteryKernelScalar;
+NearestKernel nearestKernel = nearestKernelScalar;
+static int kernelLevel = selectKernels( detectKernels() );
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Returns the fastest kernel level the CPU supports
+ *
+ * @details Checks the CPU feature flags at runtime, so one binary runs on
+ *          any x86 CPU
+ *
+ * @param in: None
+ *
+ * @return int KERNEL_AVX2, KERNEL_SSE41 or KERNEL_SCALAR
+ *
+ * @note Always KERNEL_SCALAR on other architectures
+ */
+int detectKernels()
+{
+#ifdef KERNELS_X86
+    if( __builtin_cpu_supports( "avx2" ) )
+    {
+        return KERNEL_AVX2;
+    }
+    if( __builtin_cpu_supports( "sse4.1" ) )
+    {
+        return KERNEL_SSE41;
+    }
+#endif
+
+    return KERNEL_SCALAR;
+}
+
+/**
+ * @brief Points batteryKernel and nearestKernel at the kernels of a level
+ *
+ * @details Levels above what the CPU supports are lowered to the best
+ *          supported one. There is no SSE4.1 nearest kernel, so that level
+ *          uses the scalar one
+ *
+ * @param in: level
+ *            Requested kernel level
+ *
+ * @return int level actually selected
+ *
+ * @note Not thread safe, call before starting any simulation
+ */
+int selectKernels( int level )
+{
+    level = min( level, detectKernels() );
+    batteryKernel = batteryKernelScalar;
+    nearestKernel = nearestKernelScalar;
+
+#ifdef KERNELS_X86
+    if( level == KERNEL_AVX2 )
+    {
+        batteryKernel = batteryKernelAvx2;
+        nearestKernel = nearestKernelAvx2;
+    }
+    else if( level == KERNEL_SSE41 )
+    {
+        batteryKernel = batteryKernelSse41;
+    }
+#endif
+
+    kernelLevel = level;
+    return level;
+}
+
+/**
+ * @brief Returns the kernel level in use
+ *
+ * @param in: None
+ *
+ * @return int level last chosen by selectKernels
+ *
+ * @note None
+ */
+int currentKernels()
+{
+    return kernelLevel;
+}
+
+/**
+ * @brief Returns a printable name for a kernel level
+ *
+ * @param in: level
+ *            Kernel level
+ *
+ * @return const char* name of the level
+ *
+ * @note None
+ */
+const char* kernelName( int level )
+{
+    if( level == KERNEL_AVX2 )
+    {
+        return "avx2";
+    }
+    if( level == KERNEL_SSE41 )
+    {
+        return "sse4.1";
+    }
+
+    return "scalar";
+}
+
+/**
+ * @brief Drains or charges the battery of every Drone in a range for one
+ *        minute, one Drone at a time
+ *
+ * @details In flight Drones lose 1% and are added to lowBattery if they
+ *          drop below threshold, idle Drones gain 5% up to 100%. Slots that
+ *          are not live, lost Drones, are left as they are
+ *
+ * @param in: battery
+ *            Battery array of the Fleet
+ *
+ *            inFlight
+ *            inFlight array of the Fleet
+ *
+ *            live
+ *            live array of the Fleet's drones pool
+ *
+ *            begin
+ *            First Drone index of the range
+ *
+ *            end
+ *            One past the last Drone index of the range
+ *
+ *            threshold
+ *            In flight Drones below this percent need replacing
+ *
+ *            lowBattery
+ *            Indices of in flight Drones that need replacing are appended
+ *
+ * @return void
+ *
+ * @note Reference version for the vector kernels and their tail loop
+ */
+void batteryKernelScalar( int* battery, const unsigned char* inFlight,
+                          const unsigned char* live, int begin, int end,
+                          int threshold, vector<int>& lowBattery )
+{
+    int index;
+
+    for( index = begin; index < end; index++ )
+    {
+        if( inFlight[index] ) //-1% for each minute in flight
+        {
+            battery[index]--;
+            if( battery[index] < threshold )
+            {
+                lowBattery.push_back( index );
+            }
+        }
+        else if( live[index] ) //+5% for each minute charging
+        {
+            battery[index] = min( 100, battery[index] + 5 );
+        }
+    }
+}
+
+/**
+ * @brief Finds the Drone closest to a point among a contiguous list, one
+ *        Drone at a time
+ *
+ * @details Distances are compared squared in 64 bits, so any map that fits
+ *          int coordinates works. A Drone replaces the best one if it is
+ *          closer, or as close with a lower index
+ *
+ * @param in: xPos
+ *            x coordinates of the Drones in the list
+ *
+ *            yPos
+ *            y coordinates of the Drones in the list
+ *
+ *            drones
+ *            Indices of the Drones in the list
+ *
+ *            count
+ *            Number of Drones in the list
+ *
+ *            x
+ *            x coordinate of the point
+ *
+ *            y
+ *            y coordinate of the point
+ *
+ *            bestDist
+ *            Squared distance of the best Drone so far, updated
+ *
+ *            bestIndex
+ *            Index of the best Drone so far (-1 for none), updated
+ *
+ * @return void
+ *
+ * @note Reference version for the vector kernel and its tail loop
+ */
+void nearestKernelScalar( const int* xPos, const int* yPos, const int* drones,
+                          int count, int x, int y, long long& bestDist,
+                          int& bestIndex )
+{
+    long long dx, dy, dist;
+    int member;
+
+    for( member = 0; member < count; member++ )
+    {
+        dx = (long long)xPos[member] - x;
+        dy = (long long)yPos[member] - y;
+        dist = dx * dx + dy * dy;
+        if( dist < bestDist || ( dist == bestDist && drones[member] < bestIndex ) )
+        {
+            bestDist = dist;
+            bestIndex = drones[member];
+        }
+    }
+}
+
+#ifdef KERNELS_X86
+
+/**
+ * @brief Appends the index of every set lane of a lane mask to lowBattery
+ *
+ * @param in: mask
+ *            One bit per lane, lowest bit first
+ *
+ *            index
+ *            Drone index of lane 0
+ *
+ *            lowBattery
+ *            List the indices are appended to
+ *
+ * @return void
+ *
+ * @note None
+ */
+static inline void appendLanes( int mask, int index, vector<int>& lowBattery )
+{
+    while( mask != 0 )
+    {
+        lowBattery.push_back( index + __builtin_ctz( mask ) );
+        mask &= mask - 1;
+    }
+}
+
+/**
+ * @brief SSE4.1 version of batteryKernelScalar, four Drones per step
+ *
+ * @details Both the drained and the charged battery are computed for every
+ *          lane, the live flag picks the charged one over the old one and the
+ *          inFlight flag picks the drained one
+ *
+ * @param in: See batteryKernelScalar
+ *
+ * @return void
+ *
+ * @note None
+ */
+__attribute__(( target( "sse4.1" ) ))
+void batteryKernelSse41( int* battery, const unsigned char* inFlight,
+                         const unsigned char* live, int begin, int end,
+                         int threshold, vector<int>& lowBattery )
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32( 1 );
+    const __m128i five = _mm_set1_epi32( 5 );
+    const __m128i full = _mm_set1_epi32( 100 );
+    const __m128i low = _mm_set1_epi32( threshold );
+    __m128i level, flying, alive, charged, lowLanes;
+    int index = begin;
+    int flags;
+
+    for( ; index + 4 <= end; index += 4 )
+    {
+        memcpy( &flags, inFlight + index, sizeof( flags ) );
+        flying = _mm_cmpgt_epi32( _mm_cvtepu8_epi32( _mm_cvtsi32_si128( flags ) ),
+                                  zero );
+        memcpy( &flags, live + index, sizeof( flags ) );
+        alive = _mm_cmpgt_epi32( _mm_cvtepu8_epi32( _mm_cvtsi32_si128( flags ) ),
+                                 zero );
+        level = _mm_loadu_si128( (const __m128i*)( battery + index ) );
+        charged = _mm_blendv_epi8( level,
+                                   _mm_min_epi32( _mm_add_epi32( level, five ), full ),
+                                   alive );
+        level = _mm_blendv_epi8( charged, _mm_sub_epi32( level, one ), flying );
+        _mm_storeu_si128( (__m128i*)( battery + index ), level );
+
+        lowLanes = _mm_and_si128( flying, _mm_cmplt_epi32( level, low ) );
+        appendLanes( _mm_movemask_ps( _mm_castsi128_ps( lowLanes ) ), index,
+                     lowBattery );
+    }
+
+    batteryKernelScalar( battery, inFlight, live, index, end, threshold,
+                         lowBattery );
+}
+
+/**
+ * @brief AVX2 version of batteryKernelScalar, eight Drones per step
+ *
+ * @details Both the drained and the charged battery are computed for every
+ *          lane, the live flag picks the charged one over the old one and the
+ *          inFlight flag picks the drained one
+ *
+ * @param in: See batteryKernelScalar
+ *
+ * @return void
+ *
+ * @note None
+ */
+__attribute__(( target( "avx2" ) ))
+void batteryKernelAvx2( int* battery, const unsigned char* inFlight,
+                        const unsigned char* live, int begin, int end,
+                        int threshold, vector<int>& lowBattery )
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32( 1 );
+    const __m256i five = _mm256_set1_epi32( 5 );
+    const __m256i full = _mm256_set1_epi32( 100 );
+    const __m256i low = _mm256_set1_epi32( threshold );
+    __m256i level, flying, alive, charged, lowLanes;
+    int index = begin;
+
+    for( ; index + 8 <= end; index += 8 )
+    {
+        flying = _mm256_cmpgt_epi32( _mm256_cvtepu8_epi32(
+                    _mm_loadl_epi64( (const __m128i*)( inFlight + index ) ) ),
+                    zero );
+        alive = _mm256_cmpgt_epi32( _mm256_cvtepu8_epi32(
+                    _mm_loadl_epi64( (const __m128i*)( live + index ) ) ),
+                    zero );
+        level = _mm256_loadu_si256( (const __m256i*)( battery + index ) );
+        charged = _mm256_blendv_epi8( level,
+                    _mm256_min_epi32( _mm256_add_epi32( level, five ), full ),
+                    alive );
+        level = _mm256_blendv_epi8( charged, _mm256_sub_epi32( level, one ),
+                                    flying );
+        _mm256_storeu_si256( (__m256i*)( battery + index ), level );
+
+        lowLanes = _mm256_and_si256( flying, _mm256_cmpgt_epi32( low, level ) );
+        appendLanes( _mm256_movemask_ps( _mm256_castsi256_ps( lowLanes ) ), index,
+                     lowBattery );
+    }
+
+    batteryKernelScalar( battery, inFlight, live, index, end, threshold,
+                         lowBattery );
+}
+
+/**
+ * @brief AVX2 version of nearestKernelScalar, four Drones per step
+ *
+ * @details Coordinates are widened to 64 bit lanes so squared distances
+ *          never overflow. Each lane keeps its own best squared distance and
+ *          index, and the lanes are merged with the scalar rule at the end.
+ *          Picking the closest, then lowest index, Drone does not depend on
+ *          the order Drones are looked at, so the result matches the scalar
+ *          kernel
+ *
+ * @param in: See nearestKernelScalar
+ *
+ * @return void
+ *
+ * @note Offsets from the point have to fit in an int, which holds for any
+ *       point and Drone on the map
+ */
+__attribute__(( target( "avx2" ) ))
+void nearestKernelAvx2( const int* xPos, const int* yPos, const int* drones,
+                        int count, int x, int y, long long& bestDist,
+                        int& bestIndex )
+{
+    const __m256i pointX = _mm256_set1_epi64x( x );
+    const __m256i pointY = _mm256_set1_epi64x( y );
+    __m256i laneDist = _mm256_set1_epi64x( LLONG_MAX );
+    __m256i laneIndex = _mm256_set1_epi64x( -1 );
+    __m256i dx, dy, dist, index, better;
+    long long lanesDist[4], lanesIndex[4];
+    int member = 0;
+    int lane;
+
+    if( count < 8 )
+    {
+        nearestKernelScalar( xPos, yPos, drones, count, x, y, bestDist, bestIndex );
+        return;
+    }
+
+    for( ; member + 4 <= count; member += 4 )
+    {
+        dx = _mm256_sub_epi64( _mm256_cvtepi32_epi64( _mm_loadu_si128(
+                        (const __m128i*)( xPos + member ) ) ), pointX );
+        dy = _mm256_sub_epi64( _mm256_cvtepi32_epi64( _mm_loadu_si128(
+                        (const __m128i*)( yPos + member ) ) ), pointY );
+        dist = _mm256_add_epi64( _mm256_mul_epi32( dx, dx ),
+                                 _mm256_mul_epi32( dy, dy ) );
+        index = _mm256_cvtepi32_epi64( _mm_loadu_si128(
+                        (const __m128i*)( drones + member ) ) );
+
+        better = _mm256_or_si256( _mm256_cmpgt_epi64( laneDist, dist ),
+                    _mm256_and_si256( _mm256_cmpeq_epi64( laneDist, dist ),
+                                      _mm256_cmpgt_epi64( laneIndex, index ) ) );
+        laneDist = _mm256_blendv_epi8( laneDist, dist, better );
+        laneIndex = _mm256_blendv_epi8( laneIndex, index, better );
+    }
+
+    _mm256_storeu_si256( (__m256i*)lanesDist, laneDist );
+    _mm256_storeu_si256( (__m256i*)lanesIndex, laneIndex );
+
+    for( lane = 0; lane < 4; lane++ )
+    {
+        if( lanesIndex[lane] >= 0 && ( lanesDist[lane] < bestDist
+            || ( lanesDist[lane] == bestDist && lanesIndex[lane] < bestIndex ) ) )
+        {
+            bestDist = lanesDist[lane];
+            bestIndex = lanesIndex[lane];
+        }
+    }
+
+    nearestKernelScalar( xPos + member, yPos + member, drones + member,
+                         count - member, x, y, bestDist, bestIndex );
+}
+
+#endif
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
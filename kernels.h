@@ -0,0 +1,68 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file kernels.h
+ *
+ * @details Header file for the vectorized kernels which provides prototypes
+ *          for the battery tick and nearest distance loops and their runtime
+ *          selection
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef KERNELS_H
+#define KERNELS_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Global Constants ///////////////////////////////////////////////////////////
+
+static const int KERNEL_SCALAR = 0;
+static const int KERNEL_SSE41 = 1;
+static const int KERNEL_AVX2 = 2;
+
+// Type Definitions ///////////////////////////////////////////////////////////
+
+typedef void (*BatteryKernel)( int* battery, const unsigned char* inFlight,
+                               const unsigned char* live, int begin, int end,
+                               int threshold, vector<int>& lowBattery );
+typedef void (*NearestKernel)( const int* xPos, const int* yPos,
+                               const int* drones, int count, int x, int y,
+                               long long& bestDist, int& bestIndex );
+
+// Global Variables ///////////////////////////////////////////////////////////
+
+extern BatteryKernel batteryKernel; //set by selectKernels
+extern NearestKernel nearestKernel;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+int detectKernels();
+int selectKernels( int level );
+int currentKernels();
+const char* kernelName( int level );
+void batteryKernelScalar( int* battery, const unsigned char* inFlight,
+                          const unsigned char* live, int begin, int end,
+                          int threshold, vector<int>& lowBattery );
+void batteryKernelSse41( int* battery, const unsigned char* inFlight,
+                         const unsigned char* live, int begin, int end,
+                         int threshold, vector<int>& lowBattery );
+void batteryKernelAvx2( int* battery, const unsigned char* inFlight,
+                        const unsigned char* live, int begin, int end,
+                        int threshold, vector<int>& lowBattery );
+void nearestKernelScalar( const int* xPos, const int* yPos, const int* drones,
+                          int count, int x, int y, long long& bestDist,
+                          int& bestIndex );
+void nearestKernelAvx2( const int* xPos, const int* yPos, const int* drones,
+                        int count, int x, int y, long long& bestDist,
+                        int& bestIndex );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
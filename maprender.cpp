@@ -0,0 +1,307 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file maprender.cpp
+ *
+ * @details Implementation file for the map renderer which provides function
+ *          definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef MAPRENDER_CPP
+#define MAPRENDER_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "maprender.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Appends the decimal digits of a number to a buffer
+ *
+ * @param in: buffer
+ *            Buffer to append to
+ *
+ *            value
+ *            Number to append
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void appendInt( string& buffer, int value )
+{
+    char digits[12];
+    int length = 0;
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : value;
+
+    do
+    {
+        digits[length++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while( magnitude > 0 );
+
+    if( value < 0 )
+    {
+        buffer += '-';
+    }
+
+    while( length > 0 )
+    {
+        buffer += digits[--length];
+    }
+}
+
+/**
+ * @brief Turns per position counts into offsets, leaving start[cell] at the
+ *        end of the cell's bucket so filling it backwards counts it down
+ *
+ * @param in: start
+ *            Counts by position, one extra entry at the end
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void bucketOffsets( vector<int>& start )
+{
+    int cell;
+
+    for( cell = 1; cell < (int)start.size(); cell++ )
+    {
+        start[cell] += start[cell - 1];
+    }
+}
+
+/**
+ * @brief Returns the drawn map cell holding a position
+ *
+ * @details Maps larger than MAP_DRAW_SIZE are scaled down so the drawing
+ *          keeps MAP_DRAW_SIZE + 1 positions per side, smaller maps are
+ *          drawn one position per unit
+ *
+ * @param in: xPos
+ *            x coordinate
+ *
+ *            yPos
+ *            y coordinate
+ *
+ *            mapSize
+ *            Largest coordinate on the map
+ *
+ *            side
+ *            Number of drawn positions per side
+ *
+ * @return int cell of the position, -1 if it is off the map
+ *
+ * @note None
+ */
+static int drawnCell( int xPos, int yPos, int mapSize, int side )
+{
+    if( xPos < 0 || xPos > mapSize || yPos < 0 || yPos > mapSize )
+    {
+        return -1;
+    }
+
+    return (int)( (long long)xPos * ( side - 1 ) / mapSize ) * side
+           + (int)( (long long)yPos * ( side - 1 ) / mapSize );
+}
+
+/**
+ * @brief Draws the relay map into frame.buffer
+ *
+ * @details Attached Drones, Disasters and base stations are counting sorted
+ *          by drawn position in one pass each, then the map is written out
+ *          position by position. Each position lists its Drones by
+ *          partition then index, its Disasters in set order and its base
+ *          stations, the same layout printMap has always printed. With more
+ *          than one partition Drones are labelled <base>.<droneID>. Maps
+ *          larger than MAP_DRAW_SIZE are scaled down, see drawnCell, and
+ *          positions outside the map are not drawn
+ *
+ * @param in: partitions
+ *            Fleet of each base station, all on the same map
+ *
+ *            count
+ *            Number of partitions, at least one
+ *
+ *            disasterSet
+ *            Vector containing all disaster data
+ *
+ *            frame
+ *            Reusable buckets, its buffer is filled with the map
+ *
+ * @return void
+ *
+ * @note O(fleets + disasters + bases + cells)
+ */
+void renderMap( const Fleet* partitions, int count,
+                const vector<Disaster>& disasterSet, MapFrame& frame )
+{
+    int mapSize = partitions[0].mapSize;
+    int side = min( mapSize, MAP_DRAW_SIZE ) + 1;
+    int cells = side * side;
+    int index, row, column, cell, member, drone, base;
+
+    frame.droneStart.assign( cells + 1, 0 );
+    frame.disasterStart.assign( cells + 1, 0 );
+    frame.baseStart.assign( cells + 1, 0 );
+
+    //count, offset, then fill backwards so each bucket stays in index order
+    for( base = 0; base < count; base++ )
+    {
+        const Fleet& fleet = partitions[base];
+
+        for( index = 0; index < fleet.size; index++ )
+        {
+            cell = drawnCell( fleet.xPos[index], fleet.yPos[index], mapSize,
+                              side );
+            if( fleet.disNum[index] != -1 && cell >= 0 )
+            {
+                frame.droneStart[cell]++;
+            }
+        }
+    }
+    bucketOffsets( frame.droneStart );
+    frame.droneOrder.resize( frame.droneStart[cells] );
+    frame.droneBase.resize( frame.droneStart[cells] );
+    for( base = count - 1; base >= 0; base-- )
+    {
+        const Fleet& fleet = partitions[base];
+
+        for( index = fleet.size - 1; index >= 0; index-- )
+        {
+            cell = drawnCell( fleet.xPos[index], fleet.yPos[index], mapSize,
+                              side );
+            if( fleet.disNum[index] != -1 && cell >= 0 )
+            {
+                member = --frame.droneStart[cell];
+                frame.droneOrder[member] = index;
+                frame.droneBase[member] = base;
+            }
+        }
+    }
+
+    for( index = 0; index < (int)disasterSet.size(); index++ )
+    {
+        cell = drawnCell( disasterSet[index].xPos, disasterSet[index].yPos,
+                          mapSize, side );
+        if( cell >= 0 && disasterSet[index].disNum >= 0 )
+        {
+            frame.disasterStart[cell]++;
+        }
+    }
+    bucketOffsets( frame.disasterStart );
+    frame.disasterOrder.resize( frame.disasterStart[cells] );
+    for( index = disasterSet.size() - 1; index >= 0; index-- )
+    {
+        cell = drawnCell( disasterSet[index].xPos, disasterSet[index].yPos,
+                          mapSize, side );
+        if( cell >= 0 && disasterSet[index].disNum >= 0 )
+        {
+            frame.disasterOrder[--frame.disasterStart[cell]] = index;
+        }
+    }
+
+    for( base = 0; base < count; base++ )
+    {
+        cell = drawnCell( partitions[base].baseX, partitions[base].baseY,
+                          mapSize, side );
+        if( cell >= 0 )
+        {
+            frame.baseStart[cell]++;
+        }
+    }
+    bucketOffsets( frame.baseStart );
+    frame.baseOrder.resize( frame.baseStart[cells] );
+    for( base = count - 1; base >= 0; base-- )
+    {
+        cell = drawnCell( partitions[base].baseX, partitions[base].baseY,
+                          mapSize, side );
+        if( cell >= 0 )
+        {
+            frame.baseOrder[--frame.baseStart[cell]] = base;
+        }
+    }
+
+    frame.buffer.clear();
+    frame.buffer += count > 1 ? "\nUAV:\n#<base>.<droneID> :<disaster-attached>\n\n"
+                              : "\nUAV:\n#<droneID> :<disaster-attached>\n\n";
+    frame.buffer += "Disaster:<disasterID> pos: (x,y)\n\n";
+
+    for( row = 0; row < side; row++ )
+    {
+        for( column = 0; column < side; column++ )
+        {
+            cell = row * side + column;
+
+            for( member = frame.droneStart[cell];
+                        member < frame.droneStart[cell + 1]; member++ )
+            {
+                drone = frame.droneOrder[member];
+                base = frame.droneBase[member];
+                frame.buffer += '#';
+                if( count > 1 )
+                {
+                    appendInt( frame.buffer, base );
+                    frame.buffer += '.';
+                }
+                appendInt( frame.buffer, drone );
+                frame.buffer += " :";
+                appendInt( frame.buffer, partitions[base].disNum[drone] );
+            }
+
+            for( member = frame.disasterStart[cell];
+                        member < frame.disasterStart[cell + 1]; member++ )
+            {
+                const Disaster& dis = disasterSet[frame.disasterOrder[member]];
+                frame.buffer += "DSTR:";
+                appendInt( frame.buffer, dis.disNum );
+                frame.buffer += " pos:(";
+                appendInt( frame.buffer, dis.xPos );
+                frame.buffer += ',';
+                appendInt( frame.buffer, dis.yPos );
+                frame.buffer += ')';
+            }
+
+            for( member = frame.baseStart[cell];
+                        member < frame.baseStart[cell + 1]; member++ )
+            {
+                base = frame.baseOrder[member];
+                frame.buffer += '(';
+                appendInt( frame.buffer, partitions[base].baseX );
+                frame.buffer += ',';
+                appendInt( frame.buffer, partitions[base].baseY );
+                frame.buffer += ") Base Station";
+                if( count > 1 )
+                {
+                    frame.buffer += " #";
+                    appendInt( frame.buffer, base );
+                }
+            }
+
+            if( row == side - 1 && column == side - 1 )
+            {
+                frame.buffer += '(';
+                appendInt( frame.buffer, mapSize );
+                frame.buffer += ',';
+                appendInt( frame.buffer, mapSize );
+                frame.buffer += ") Max";
+            }
+            frame.buffer += ' ';
+        }
+        frame.buffer += '\n';
+    }
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,35 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file maprender.h
+ *
+ * @details Header file for the map renderer which provides prototypes for
+ *          drawing the relay map into a reusable buffer
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef MAPRENDER_H
+#define MAPRENDER_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Global Constants ///////////////////////////////////////////////////////////
+
+static const int MAP_DRAW_SIZE = 100; //larger maps are scaled down to this
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+void renderMap( const Fleet* partitions, int count,
+                const vector<Disaster>& disasterSet, MapFrame& frame );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,231 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file packets.cpp
+ *
+ * @details Implementation file for the packet throughput engine which
+ *          provides function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef PACKETS_CPP
+#define PACKETS_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+#include "packets.h"
+#include "spatialgrid.h"
+#include "relays.h"
+#include "telemetry.h"
+#include "simulator.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Clears the counters and hop histogram of a PacketBatch
+ *
+ * @details The scratch arrays keep their capacity
+ *
+ * @param in: batch
+ *            Batch to reset
+ *
+ * @return void
+ *
+ * @note None
+ */
+void resetPacketBatch( PacketBatch& batch )
+{
+    batch.hopHistogram.clear();
+    batch.delivered = 0;
+    batch.dropped = 0;
+    batch.replaced = 0;
+    batch.seconds = 0;
+}
+
+/**
+ * @brief Sends a batch of packets from the given coordinates to the Command
+ *        and Control Center
+ *
+ * @details Works in three passes instead of walking the relay once per
+ *          packet:
+ *          1. Every source is resolved to its entry Drone, the closest in
+ *             flight Drone, and packets are counted per entry Drone. A
+ *             source with no Drone in range is dropped
+ *          2. Each distinct entry Drone walks its previous chain once,
+ *             adding its packet count to the load of every Drone on the way
+ *             and to the hop histogram
+ *          3. Every loaded Drone loses 1% per packet it relayed, then the
+ *             ones in flight below fleet.lowBattery are replaced in index order
+ *          Unlike sendPacket, no Drone is replaced partway through the batch
+ *          and nothing is printed per hop
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            xPos
+ *            x coordinates the packets are sent from
+ *
+ *            yPos
+ *            y coordinates the packets are sent from
+ *
+ *            count
+ *            Number of packets
+ *
+ *            batch
+ *            Scratch space, and counters the results are added to
+ *
+ * @return void
+ *
+ * @note O(count * findClosest + relayed Drones + replacements)
+ */
+void sendPacketBatch( Fleet& fleet, const int* xPos, const int* yPos,
+                      int count, PacketBatch& batch )
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<int>& load = batch.load;
+    vector<int>& lowBattery = batch.lowBattery;
+    int packet, entry, current, hops, index;
+    long delivered = batch.delivered;
+    long dropped = batch.dropped;
+
+    if( (int)load.size() != fleet.size )
+    {
+        load.assign( fleet.size, 0 );
+    }
+    batch.entries.clear();
+    batch.touched.clear();
+    lowBattery.clear();
+
+    //1. count packets per entry Drone
+    for( packet = 0; packet < count; packet++ )
+    {
+        entry = gridNearest( fleet, xPos[packet], yPos[packet] );
+        if( entry < 0 || !inReach( fleet, fleet.xPos[entry], fleet.yPos[entry],
+                                   xPos[packet], yPos[packet] ) )
+        {
+            batch.dropped++;
+            continue;
+        }
+
+        if( load[entry] == 0 )
+        {
+            batch.entries.push_back( entry );
+        }
+        load[entry]++;
+    }
+
+    //entry counts move out of load so the walks can reuse it
+    batch.entryCounts.resize( batch.entries.size() );
+    for( index = 0; index < (int)batch.entries.size(); index++ )
+    {
+        batch.entryCounts[index] = load[batch.entries[index]];
+        load[batch.entries[index]] = 0;
+    }
+
+    //2. walk each relay once per entry Drone
+    for( index = 0; index < (int)batch.entries.size(); index++ )
+    {
+        current = batch.entries[index];
+        hops = 0;
+
+        //a relay never holds more Drones than the fleet
+        while( current >= 0 && hops < fleet.size )
+        {
+            if( load[current] == 0 )
+            {
+                batch.touched.push_back( current );
+            }
+            load[current] += batch.entryCounts[index];
+            hops++;
+            current = fleet.previous[current];
+        }
+
+        if( (int)batch.hopHistogram.size() <= hops )
+        {
+            batch.hopHistogram.resize( hops + 1, 0 );
+        }
+        batch.hopHistogram[hops] += batch.entryCounts[index];
+        batch.delivered += batch.entryCounts[index];
+    }
+
+    //3. charge every loaded Drone, then replace the low ones
+    for( index = 0; index < (int)batch.touched.size(); index++ )
+    {
+        current = batch.touched[index];
+        relayDrain( fleet, current, load[current] );
+        load[current] = 0;
+
+        if( fleet.inFlight[current] && fleet.battery[current] < fleet.lowBattery )
+        {
+            lowBattery.push_back( current );
+        }
+    }
+
+    sort( lowBattery.begin(), lowBattery.end() );
+    for( index = 0; index < (int)lowBattery.size(); index++ )
+    {
+        if( replaceDrone( lowBattery[index], fleet, -1 ) )
+        {
+            batch.replaced++;
+        }
+    }
+
+    logEvent( fleet, EVENT_PACKET_BATCH, -1, batch.delivered - delivered,
+              batch.dropped - dropped, -1 );
+    batch.seconds += chrono::duration<double>(
+                            chrono::steady_clock::now() - start ).count();
+}
+
+/**
+ * @brief Prints the counters and hop histogram of a PacketBatch
+ *
+ * @details Throughput is packets delivered or dropped per second spent in
+ *          sendPacketBatch
+ *
+ * @param in: out
+ *            Stream to print to
+ *
+ *            batch
+ *            Batch to report on
+ *
+ * @return void
+ *
+ * @note None
+ */
+void printPacketStats( ostream& out, const PacketBatch& batch )
+{
+    long sent = batch.delivered + batch.dropped;
+    int hops;
+
+    out << '\n'
+        << "Packets delivered: " << batch.delivered << '\n'
+        << "Packets dropped: " << batch.dropped << '\n'
+        << "Drones replaced: " << batch.replaced << '\n';
+
+    if( batch.seconds > 0 )
+    {
+        out << "Packets per second: " << (long)( sent / batch.seconds ) << '\n';
+    }
+
+    out << "Hops  Packets" << '\n';
+    for( hops = 0; hops < (int)batch.hopHistogram.size(); hops++ )
+    {
+        if( batch.hopHistogram[hops] > 0 )
+        {
+            out << setw( 4 ) << hops << "  " << batch.hopHistogram[hops] << '\n';
+        }
+    }
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,33 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file packets.h
+ *
+ * @details Header file for the packet throughput engine which provides
+ *          prototypes for sending packets in batches
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef PACKETS_H
+#define PACKETS_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+void resetPacketBatch( PacketBatch& batch );
+void sendPacketBatch( Fleet& fleet, const int* xPos, const int* yPos,
+                      int count, PacketBatch& batch );
+void printPacketStats( ostream& out, const PacketBatch& batch );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
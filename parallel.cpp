@@ -0,0 +1,282 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file parallel.cpp
+ *
+ * @details Implementation file for the worker thread helpers which provides
+ *          function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef PARALLEL_CPP
+#define PARALLEL_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "parallel.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Creates a pool with no threads, they start with the first round
+ *        that needs them
+ *
+ * @param in: None
+ *
+ * @return None
+ *
+ * @note None
+ */
+WorkerPool::WorkerPool()
+{
+    body = NULL;
+    count = 0;
+    parts = 0;
+    round = 0;
+    running = 0;
+    stopping = false;
+}
+
+/**
+ * @brief Wakes every thread of the pool to stop and joins it
+ *
+ * @param in: None
+ *
+ * @return None
+ *
+ * @note Must not run while a round is in progress
+ */
+WorkerPool::~WorkerPool()
+{
+    int member;
+
+    {
+        lock_guard<mutex> guard( lock );
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for( member = 0; member < (int)threads.size(); member++ )
+    {
+        threads[member].join();
+    }
+}
+
+/**
+ * @brief Loop of one pool thread, runs its part of every round until the
+ *        pool stops
+ *
+ * @details Sleeps on wake between rounds. A thread whose part number is
+ *          not below the round's parts sits the round out
+ *
+ * @param in: pool
+ *            Pool the thread belongs to
+ *
+ *            part
+ *            Part the thread runs, 1 or more
+ *
+ *            seen
+ *            Round that had started when the thread was created
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void workerLoop( WorkerPool* pool, int part, long seen )
+{
+    unique_lock<mutex> guard( pool->lock );
+    int count, parts;
+
+    while( true )
+    {
+        pool->wake.wait( guard, [&]()
+        {
+            return pool->stopping || pool->round != seen;
+        } );
+
+        if( pool->stopping )
+        {
+            return;
+        }
+
+        seen = pool->round;
+        if( part < pool->parts )
+        {
+            count = pool->count;
+            parts = pool->parts;
+            guard.unlock();
+            ( *pool->body )( part, (int)( (long long)part * count / parts ),
+                             (int)( (long long)( part + 1 ) * count / parts ) );
+            guard.lock();
+
+            pool->running--;
+            if( pool->running == 0 )
+            {
+                pool->done.notify_one();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Returns the number of worker threads to use when none is given
+ *
+ * @details One per hardware thread, or one if that cannot be detected
+ *
+ * @param in: None
+ *
+ * @return int number of workers
+ *
+ * @note None
+ */
+int defaultWorkers()
+{
+    return max( 1, (int)thread::hardware_concurrency() );
+}
+
+/**
+ * @brief Decides how many parts a loop over count items is split into
+ *
+ * @details Never more parts than workers, and every part gets at least
+ *          PARALLEL_MIN_ITEMS items so thread start up stays negligible
+ *
+ * @param in: count
+ *            Number of items in the loop
+ *
+ *            workers
+ *            Maximum number of threads
+ *
+ * @return int number of parts, 1 means run serially
+ *
+ * @note None
+ */
+int partitionCount( int count, int workers )
+{
+    return max( 1, min( workers, count / PARALLEL_MIN_ITEMS ) );
+}
+
+/**
+ * @brief Runs body over [0, count) split into contiguous parts, one thread
+ *        per part
+ *
+ * @details Part p covers items [p * count / parts, (p + 1) * count / parts).
+ *          The calling thread runs part 0 and waits for the others, so a
+ *          single part runs without touching the pool. The other parts run
+ *          on the pool's threads, which are created the first time and then
+ *          only woken, so calling this every simulated minute costs a wake
+ *          up per part rather than a thread start
+ *
+ * @param in: pool
+ *            Threads to run the parts on, created when empty
+ *
+ *            count
+ *            Number of items in the loop
+ *
+ *            parts
+ *            Number of parts, usually from partitionCount
+ *
+ *            body
+ *            Called once per part with the part number and its item range
+ *
+ * @return void
+ *
+ * @note Parts must not write to shared data without their own locking
+ */
+void parallelFor( shared_ptr<WorkerPool>& pool, int count, int parts,
+                  const function<void( int part, int begin, int end )>& body )
+{
+    if( parts <= 1 )
+    {
+        body( 0, 0, count );
+        return;
+    }
+
+    if( !pool )
+    {
+        pool = make_shared<WorkerPool>();
+    }
+
+    lock_guard<mutex> turn( pool->submit );
+
+    while( (int)pool->threads.size() < parts - 1 )
+    {
+        pool->threads.push_back( thread( workerLoop, pool.get(),
+                                         (int)pool->threads.size() + 1,
+                                         pool->round ) );
+    }
+
+    {
+        lock_guard<mutex> guard( pool->lock );
+        pool->body = &body;
+        pool->count = count;
+        pool->parts = parts;
+        pool->running = parts - 1;
+        pool->round++;
+    }
+    pool->wake.notify_all();
+
+    body( 0, 0, (int)( (long long)count / parts ) );
+
+    unique_lock<mutex> guard( pool->lock );
+    pool->done.wait( guard, [&]()
+    {
+        return pool->running == 0;
+    } );
+}
+
+/**
+ * @brief Runs body on every item of [0, count) with a pool of worker
+ *        threads that take the next unclaimed item as they finish one
+ *
+ * @details Unlike parallelFor the items are not split up front, so items
+ *          that take very different times still keep every worker busy
+ *          until the queue runs dry. Items are claimed in increasing order
+ *          but may finish in any order
+ *
+ * @param in: count
+ *            Number of items
+ *
+ *            workers
+ *            Number of threads, the calling thread is worker 0
+ *
+ *            body
+ *            Called once per item with the worker running it and the item
+ *
+ * @return void
+ *
+ * @note Items must not write to shared data without their own locking,
+ *       per worker scratch space can be indexed by the worker number
+ */
+void parallelQueue( int count, int workers,
+                    const function<void( int worker, int item )>& body )
+{
+    shared_ptr<WorkerPool> pool;
+    atomic<int> nextItem( 0 );
+
+    workers = max( 1, min( workers, count ) );
+    parallelFor( pool, workers, workers, [&]( int worker, int, int )
+    {
+        int item;
+
+        for( item = nextItem++; item < count; item = nextItem++ )
+        {
+            body( worker, item );
+        }
+    } );
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,39 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file parallel.h
+ *
+ * @details Header file for the worker thread helpers which provide
+ *          prototypes for splitting a loop across a pool of threads
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <functional>
+#include <memory>
+#include "structs.h"
+
+using namespace std;
+
+// Global Constants ///////////////////////////////////////////////////////////
+
+static const int PARALLEL_MIN_ITEMS = 32768; //smallest range worth a thread
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+int defaultWorkers();
+int partitionCount( int count, int workers );
+void parallelFor( shared_ptr<WorkerPool>& pool, int count, int parts,
+                  const function<void( int part, int begin, int end )>& body );
+void parallelQueue( int count, int workers,
+                    const function<void( int worker, int item )>& body );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
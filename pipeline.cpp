@@ -0,0 +1,727 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file pipeline.cpp
+ *
+ * @details Implementation file for the packet pipeline which provides
+ *          function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef PIPELINE_CPP
+#define PIPELINE_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "pipeline.h"
+#include "pool.h"
+#include "instrument.h"
+#include "spatialgrid.h"
+#include "relays.h"
+#include "repair.h"
+#include "bases.h"
+#include "telemetry.h"
+#include "simulator.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Grows the arrays of a pipeline indexed by Drone to the Fleet
+ *
+ * @param in: fleet
+ *            Fleet the pipeline belongs to
+ *
+ *            pipe
+ *            Pipeline to grow
+ *
+ * @return void
+ *
+ * @note Only allocates when the Fleet has grown since the last call
+ */
+static void pipelineFit( const Fleet& fleet, PacketPipeline& pipe )
+{
+    if( (int)pipe.queueHead.size() >= fleet.size )
+    {
+        return;
+    }
+
+    pipe.queueHead.resize( fleet.size, -1 );
+    pipe.queueTail.resize( fleet.size, -1 );
+    pipe.queueLength.resize( fleet.size, 0 );
+    pipe.peakDepth.resize( fleet.size, 0 );
+    pipe.listed.resize( fleet.size, 0 );
+    pipe.sent.resize( fleet.size, 0 );
+    pipe.drops.resize( fleet.size, 0 );
+}
+
+/**
+ * @brief Adds a packet to the back of a Drone's queue
+ *
+ * @param in: pipe
+ *            Pipeline holding the queue
+ *
+ *            drone
+ *            Index of the Drone, its queue not full
+ *
+ *            packet
+ *            Packet to add
+ *
+ * @return void
+ *
+ * @note O(1) amortized
+ */
+static void queuePush( PacketPipeline& pipe, int drone, int packet )
+{
+    pipe.link[packet] = -1;
+    if( pipe.queueLength[drone] == 0 )
+    {
+        pipe.queueHead[drone] = packet;
+    }
+    else
+    {
+        pipe.link[pipe.queueTail[drone]] = packet;
+    }
+    pipe.queueTail[drone] = packet;
+
+    if( !pipe.listed[drone] )
+    {
+        pipe.listed[drone] = 1;
+        pipe.active.push_back( drone );
+    }
+    pipe.queueLength[drone]++;
+    pipe.peakDepth[drone] = max( pipe.peakDepth[drone], pipe.queueLength[drone] );
+    pipe.queued++;
+}
+
+/**
+ * @brief Returns the packet at the front of a Drone's queue
+ *
+ * @param in: pipe
+ *            Pipeline holding the queue
+ *
+ *            drone
+ *            Index of the Drone, its queue not empty
+ *
+ * @return int the packet
+ *
+ * @note O(1)
+ */
+static int queueFront( const PacketPipeline& pipe, int drone )
+{
+    return pipe.queueHead[drone];
+}
+
+/**
+ * @brief Takes the packet at the front of a Drone's queue out of it
+ *
+ * @param in: pipe
+ *            Pipeline holding the queue
+ *
+ *            drone
+ *            Index of the Drone, its queue not empty
+ *
+ * @return int the packet
+ *
+ * @note O(1)
+ */
+static int queuePop( PacketPipeline& pipe, int drone )
+{
+    int packet = queueFront( pipe, drone );
+
+    pipe.queueHead[drone] = pipe.link[packet];
+    pipe.queueLength[drone]--;
+    pipe.queued--;
+
+    return packet;
+}
+
+/**
+ * @brief Drops every packet queued at a Drone
+ *
+ * @param in: pipe
+ *            Pipeline holding the queue
+ *
+ *            drone
+ *            Index of the Drone
+ *
+ * @return void
+ *
+ * @note O(queue length)
+ */
+static void dropQueue( PacketPipeline& pipe, int drone )
+{
+    while( pipe.queueLength[drone] > 0 )
+    {
+        poolRelease( pipe.packets, queuePop( pipe, drone ) );
+        pipe.drops[drone]++;
+        pipe.dropped++;
+    }
+}
+
+/**
+ * @brief Empties a pipeline and gives it the default settings
+ *
+ * @details Packets take DEFAULT_HOP_TICKS to cross a link, queues hold
+ *          DEFAULT_QUEUE_CAPACITY packets, Drones send DEFAULT_SEND_RATE
+ *          packets a tick, a minute has DEFAULT_TICKS_PER_MINUTE ticks and a
+ *          Drone loses 1% for every DEFAULT_PACKETS_PER_PERCENT packets it
+ *          sends. The settings can be changed between ticks
+ *
+ * @param in: pipe
+ *            Pipeline to reset
+ *
+ * @return void
+ *
+ * @note None
+ */
+void pipelineReset( PacketPipeline& pipe )
+{
+    pipe.hopTicks = DEFAULT_HOP_TICKS;
+    pipe.queueCapacity = DEFAULT_QUEUE_CAPACITY;
+    pipe.sendRate = DEFAULT_SEND_RATE;
+    pipe.ticksPerMinute = DEFAULT_TICKS_PER_MINUTE;
+    pipe.packetsPerPercent = DEFAULT_PACKETS_PER_PERCENT;
+    pipe.tick = 0;
+    poolReset( pipe.packets, 0 );
+    pipe.sentTick.clear();
+    pipe.readyTick.clear();
+    pipe.link.clear();
+    pipe.queueHead.clear();
+    pipe.queueTail.clear();
+    pipe.queueLength.clear();
+    pipe.peakDepth.clear();
+    pipe.active.clear();
+    pipe.listed.clear();
+    pipe.sent.clear();
+    pipe.drops.clear();
+    pipe.latency.clear();
+    pipe.lowBattery.clear();
+    pipe.injected = 0;
+    pipe.delivered = 0;
+    pipe.dropped = 0;
+    pipe.unreachable = 0;
+    pipe.queued = 0;
+    pipe.depthTotal = 0;
+}
+
+/**
+ * @brief Puts a packet from the given coordinates into the relays
+ *
+ * @details The packet enters at the closest in flight Drone, like
+ *          sendPacketFrom, and reaches its queue hopTicks later. It is
+ *          dropped at that Drone if the queue is full
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            pipe
+ *            Pipeline of the Fleet
+ *
+ *            xPos
+ *            x coordinate the packet is sent from
+ *
+ *            yPos
+ *            y coordinate the packet is sent from
+ *
+ * @return bool Evidence that the packet was queued
+ *
+ * @note O(findClosest)
+ */
+bool pipelineInject( Fleet& fleet, PacketPipeline& pipe, int xPos, int yPos )
+{
+    int entry = gridNearest( fleet, xPos, yPos );
+    int packet;
+
+    if( entry < 0 || !inReach( fleet, fleet.xPos[entry], fleet.yPos[entry],
+                               xPos, yPos ) )
+    {
+        pipe.unreachable++;
+        return false;
+    }
+
+    pipelineFit( fleet, pipe );
+    pipe.injected++;
+
+    if( pipe.queueLength[entry] >= pipe.queueCapacity )
+    {
+        pipe.drops[entry]++;
+        pipe.dropped++;
+        return false;
+    }
+
+    packet = poolAcquire( pipe.packets );
+    if( packet >= (int)pipe.sentTick.size() )
+    {
+        pipe.sentTick.resize( packet + 1 );
+        pipe.readyTick.resize( packet + 1 );
+        pipe.link.resize( packet + 1 );
+    }
+
+    pipe.sentTick[packet] = pipe.tick;
+    pipe.readyTick[packet] = pipe.tick + pipe.hopTicks;
+    queuePush( pipe, entry, packet );
+
+    return true;
+}
+
+/**
+ * @brief Moves the packets of a pipeline on by one tick
+ *
+ * @details Every Drone with a queue, in index order, sends up to sendRate
+ *          packets that have finished crossing their last link, front of
+ *          the queue first, to its previous Drone, or delivers them when it
+ *          hangs off the base station. A packet sent to a full queue is
+ *          dropped at that Drone, and a packet sent this tick cannot move
+ *          again before hopTicks have passed. Packets still queued at a
+ *          Drone that has landed since the last tick are dropped there, and
+ *          a Drone with no battery left holds its queue until it is
+ *          replaced. Sending costs battery like sendPacket, and the Drones
+ *          sending dropped below fleet.lowBattery are replaced after the
+ *          tick in index order, their queues going with their place in the
+ *          relay. A Drone that cannot be replaced is passed to repairRelay,
+ *          as in updateBatteries
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            pipe
+ *            Pipeline of the Fleet
+ *
+ * @return void
+ *
+ * @note O(a log a + packets sent) for a Drones with a queue, the clock of
+ *       the Fleet does not move
+ */
+void pipelineStep( Fleet& fleet, PacketPipeline& pipe )
+{
+    INSTRUMENT_SCOPE( PROBE_PIPELINE_STEP );
+    int member, last, drone, count, packet, next, battery, index;
+    long now, ticks;
+
+    pipelineFit( fleet, pipe );
+    pipe.tick++;
+    now = pipe.tick;
+    pipe.lowBattery.clear();
+
+    //Drones listed during the tick only hold packets that are not ready
+    sort( pipe.active.begin(), pipe.active.end() );
+    last = pipe.active.size();
+    for( member = 0; member < last; member++ )
+    {
+        drone = pipe.active[member];
+        if( pipe.queueLength[drone] == 0 )
+        {
+            continue;
+        }
+
+        if( !fleet.inFlight[drone] )
+        {
+            dropQueue( pipe, drone );
+            continue;
+        }
+
+        battery = fleet.battery[drone];
+        for( count = 0; count < pipe.sendRate && fleet.battery[drone] > 0
+                   && pipe.queueLength[drone] > 0
+                   && pipe.readyTick[queueFront( pipe, drone )] <= now; count++ )
+        {
+            packet = queuePop( pipe, drone );
+            pipe.sent[drone]++;
+            if( pipe.packetsPerPercent > 0
+                 && pipe.sent[drone] % pipe.packetsPerPercent == 0 )
+            {
+                relayDrain( fleet, drone, 1 );
+            }
+
+            next = fleet.previous[drone];
+            if( next < 0 )
+            {
+                ticks = now + pipe.hopTicks - pipe.sentTick[packet];
+                if( (long)pipe.latency.size() <= ticks )
+                {
+                    pipe.latency.resize( ticks + 1, 0 );
+                }
+                pipe.latency[ticks]++;
+                pipe.delivered++;
+                poolRelease( pipe.packets, packet );
+            }
+            else if( pipe.queueLength[next] >= pipe.queueCapacity )
+            {
+                pipe.drops[next]++;
+                pipe.dropped++;
+                poolRelease( pipe.packets, packet );
+            }
+            else
+            {
+                pipe.readyTick[packet] = now + pipe.hopTicks;
+                queuePush( pipe, next, packet );
+            }
+        }
+
+        INSTRUMENT_SCANNED( PROBE_PIPELINE_STEP, count );
+        if( battery >= fleet.lowBattery && fleet.battery[drone] < fleet.lowBattery )
+        {
+            pipe.lowBattery.push_back( drone );
+        }
+    }
+
+    pipe.depthTotal += pipe.queued;
+
+    for( index = 0; index < (int)pipe.lowBattery.size(); index++ )
+    {
+        drone = pipe.lowBattery[index];
+        if( !replaceDrone( drone, fleet, -1 ) && !repairRelay( drone, fleet, -1 ) )
+        {
+            logEvent( fleet, EVENT_REPLACE_FAILED, drone, -1, -1, -1 );
+            if( fleet.console )
+            {
+                cout << "No drones available to replace drone #" << drone
+                     << '\n';
+            }
+        }
+    }
+
+    //keep the Drones that still hold packets
+    last = 0;
+    for( member = 0; member < (int)pipe.active.size(); member++ )
+    {
+        drone = pipe.active[member];
+        if( pipe.queueLength[drone] > 0 )
+        {
+            pipe.active[last] = drone;
+            last++;
+        }
+        else
+        {
+            pipe.listed[drone] = 0;
+        }
+    }
+    pipe.active.resize( last );
+}
+
+/**
+ * @brief Moves the queue of a Drone being replaced to its replacement
+ *
+ * @details Called by replaceDrone, does nothing when the Fleet has no
+ *          pipeline attached. Anything left in the replacement's own queue
+ *          from before it landed is dropped first
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            Index of the Drone being replaced
+ *
+ *            newIndex
+ *            Index of the replacement
+ *
+ * @return void
+ *
+ * @note O(queue lengths)
+ */
+void pipelineHandOver( Fleet& fleet, int index, int newIndex )
+{
+    PacketPipeline* pipe = fleet.pipeline;
+
+    if( pipe == NULL || index >= (int)pipe->queueHead.size() )
+    {
+        return;
+    }
+
+    pipelineFit( fleet, *pipe );
+    dropQueue( *pipe, newIndex );
+    while( pipe->queueLength[index] > 0 )
+    {
+        queuePush( *pipe, newIndex, queuePop( *pipe, index ) );
+    }
+}
+
+/**
+ * @brief Moves the queue of a Drone retired by repairRelay to the Drone it
+ *        was sending to
+ *
+ * @details Called by repairRelay before the Drone is unlinked, does nothing
+ *          when the Fleet has no pipeline attached. Packets keep their ready
+ *          tick and join the back of upstream's queue while it has room. The
+ *          rest, and every packet when upstream is the base station, are
+ *          counted as dropped at the retired Drone
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            Index of the Drone being retired
+ *
+ *            upstream
+ *            Drone index was sending to, -1 for the base station
+ *
+ * @return void
+ *
+ * @note O(queue length)
+ */
+void pipelineRetire( Fleet& fleet, int index, int upstream )
+{
+    PacketPipeline* pipe = fleet.pipeline;
+
+    if( pipe == NULL || index >= (int)pipe->queueHead.size() )
+    {
+        return;
+    }
+
+    pipelineFit( fleet, *pipe );
+    while( upstream >= 0 && pipe->queueLength[index] > 0
+           && pipe->queueLength[upstream] < pipe->queueCapacity )
+    {
+        queuePush( *pipe, upstream, queuePop( *pipe, index ) );
+    }
+    dropQueue( *pipe, index );
+}
+
+/**
+ * @brief Returns a percentile of the latency of delivered packets
+ *
+ * @param in: pipe
+ *            Pipeline to look at
+ *
+ *            fraction
+ *            Fraction of delivered packets at or below the result, .5 for
+ *            the median
+ *
+ * @return long latency in ticks, -1 if no packet was delivered
+ *
+ * @note O(longest latency)
+ */
+long pipelinePercentile( const PacketPipeline& pipe, double fraction )
+{
+    long target = max( 1L, (long)ceil( fraction * pipe.delivered ) );
+    long seen = 0;
+    long ticks;
+
+    if( pipe.delivered == 0 )
+    {
+        return -1;
+    }
+
+    for( ticks = 0; ticks < (long)pipe.latency.size(); ticks++ )
+    {
+        seen += pipe.latency[ticks];
+        if( seen >= target )
+        {
+            return ticks;
+        }
+    }
+
+    return pipe.latency.size() - 1;
+}
+
+/**
+ * @brief Runs traffic from every active Disaster through the relays of a
+ *        network for a number of minutes
+ *
+ * @details Each minute perMinute packets are spread evenly over its ticks,
+ *          cycling over the active Disaster sites, and sent into the
+ *          pipeline of the partition networkRoute picks for the site at the
+ *          start of the minute. Every pipeline then runs the tick. After the
+ *          last tick of a minute the network advances one minute, so Drones
+ *          drain and are replaced while packets are on their way. Each
+ *          partition keeps its own pipeline, attached to it while the
+ *          traffic runs so replaceDrone can hand queues over
+ *
+ * @param in: network
+ *            Fleets of all base stations
+ *
+ *            disasterSet
+ *            Vector containing all disaster data
+ *
+ *            perMinute
+ *            Packets sent each minute, 0 to let the queues drain
+ *
+ *            minutes
+ *            Number of minutes to run
+ *
+ *            pipelines
+ *            One pipeline per partition, new ones are reset
+ *
+ * @return bool Evidence that there was a site to send from, or no packet to
+ *         send
+ *
+ * @note O(minutes * ( ticksPerMinute * pipelineStep + perMinute *
+ *       findClosest + advanceTime ))
+ */
+bool networkTraffic( BaseNetwork& network, const vector<Disaster>& disasterSet,
+                     int perMinute, int minutes,
+                     vector<PacketPipeline>& pipelines )
+{
+    vector<int> sites, route;
+    int parts = network.partitions.size();
+    int base, disIndex, minute, tick, site, ticks;
+    long packet, count;
+    long cursor = 0;
+
+    for( disIndex = 0; disIndex < (int)disasterSet.size(); disIndex++ )
+    {
+        if( disasterSet[disIndex].disNum >= 0 )
+        {
+            sites.push_back( disIndex );
+        }
+    }
+
+    if( sites.empty() && perMinute > 0 )
+    {
+        return false;
+    }
+
+    base = pipelines.size();
+    pipelines.resize( max( (int)pipelines.size(), parts ) );
+    for( ; base < (int)pipelines.size(); base++ )
+    {
+        pipelineReset( pipelines[base] );
+    }
+
+    for( base = 0; base < parts; base++ )
+    {
+        network.partitions[base].pipeline = &pipelines[base];
+    }
+
+    route.resize( sites.size() );
+    for( minute = 0; minute < minutes; minute++ )
+    {
+        for( site = 0; site < (int)sites.size(); site++ )
+        {
+            route[site] = max( 0, networkRoute( network,
+                                                disasterSet[sites[site]].xPos,
+                                                disasterSet[sites[site]].yPos ) );
+        }
+
+        ticks = pipelines[0].ticksPerMinute;
+        for( tick = 0; tick < ticks; tick++ )
+        {
+            count = (long)perMinute * ( tick + 1 ) / ticks
+                    - (long)perMinute * tick / ticks;
+            for( packet = 0; packet < count; packet++ )
+            {
+                site = cursor % sites.size();
+                cursor++;
+                base = route[site];
+                pipelineInject( network.partitions[base], pipelines[base],
+                                disasterSet[sites[site]].xPos,
+                                disasterSet[sites[site]].yPos );
+            }
+
+            for( base = 0; base < parts; base++ )
+            {
+                pipelineStep( network.partitions[base], pipelines[base] );
+            }
+        }
+
+        networkAdvance( network, 1 );
+    }
+
+    for( base = 0; base < parts; base++ )
+    {
+        network.partitions[base].pipeline = NULL;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Prints the totals, latency percentiles, queue depth and drops of
+ *        a pipeline
+ *
+ * @details Drones are listed by packets dropped, the five with the most
+ *          first, ties to the lowest index
+ *
+ * @param in: out
+ *            Stream to print to
+ *
+ *            pipe
+ *            Pipeline to report
+ *
+ * @return void
+ *
+ * @note O(n + longest latency)
+ */
+void printPipelineStats( ostream& out, const PacketPipeline& pipe )
+{
+    const int listed = 5;
+    long lastDrops = -1;
+    int lastDrone = -1;
+    int deepest = -1;
+    int rank, drone, best;
+
+    out << '\n'
+        << "Packets injected: " << pipe.injected << '\n'
+        << "Packets delivered: " << pipe.delivered << '\n'
+        << "Packets dropped: " << pipe.dropped << '\n'
+        << "Packets unreachable: " << pipe.unreachable << '\n'
+        << "Packets in flight: " << pipe.queued << '\n';
+
+    if( pipe.delivered > 0 )
+    {
+        out << "Latency in ticks (" << pipe.ticksPerMinute << " per minute): p50 "
+            << pipelinePercentile( pipe, .5 ) << ", p90 "
+            << pipelinePercentile( pipe, .9 ) << ", p99 "
+            << pipelinePercentile( pipe, .99 ) << ", max "
+            << pipe.latency.size() - 1 << '\n';
+    }
+
+    for( drone = 0; drone < (int)pipe.peakDepth.size(); drone++ )
+    {
+        if( deepest < 0 || pipe.peakDepth[drone] > pipe.peakDepth[deepest] )
+        {
+            deepest = drone;
+        }
+    }
+
+    if( pipe.tick > 0 && deepest >= 0 )
+    {
+        out << "Queue depth: " << pipe.depthTotal / pipe.tick
+            << " packets queued on average, deepest queue "
+            << pipe.peakDepth[deepest]
+            << " of " << pipe.queueCapacity << " at drone #" << deepest << '\n';
+    }
+
+    //each pass finds the next Drone after lastDrops, lastDrone in the order
+    for( rank = 0; rank < listed; rank++ )
+    {
+        best = -1;
+        for( drone = 0; drone < (int)pipe.drops.size(); drone++ )
+        {
+            if( pipe.drops[drone] > 0
+                 && ( lastDrone < 0 || pipe.drops[drone] < lastDrops
+                      || ( pipe.drops[drone] == lastDrops && drone > lastDrone ) )
+                 && ( best < 0 || pipe.drops[drone] > pipe.drops[best] ) )
+            {
+                best = drone;
+            }
+        }
+
+        if( best < 0 )
+        {
+            break;
+        }
+
+        out << ( rank == 0 ? "Drops by drone: #" : ", #" ) << best << " "
+            << pipe.drops[best];
+        lastDrops = pipe.drops[best];
+        lastDrone = best;
+    }
+
+    if( lastDrone >= 0 )
+    {
+        out << '\n';
+    }
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
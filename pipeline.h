@@ -0,0 +1,40 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file pipeline.h
+ *
+ * @details Header file for the packet pipeline which provides prototypes
+ *          for moving packets through the relays a hop at a time as the
+ *          simulation clock runs
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+void pipelineReset( PacketPipeline& pipe );
+bool pipelineInject( Fleet& fleet, PacketPipeline& pipe, int xPos, int yPos );
+void pipelineStep( Fleet& fleet, PacketPipeline& pipe );
+void pipelineHandOver( Fleet& fleet, int index, int newIndex );
+void pipelineRetire( Fleet& fleet, int index, int upstream );
+long pipelinePercentile( const PacketPipeline& pipe, double fraction );
+bool networkTraffic( BaseNetwork& network, const vector<Disaster>& disasterSet,
+                     int perMinute, int minutes,
+                     vector<PacketPipeline>& pipelines );
+void printPipelineStats( ostream& out, const PacketPipeline& pipe );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
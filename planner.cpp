@@ -0,0 +1,284 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file planner.cpp
+ *
+ * @details Implementation file for the relay planner which provides
+ *          function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef PLANNER_CPP
+#define PLANNER_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "planner.h"
+#include "spatialgrid.h"
+#include "simulator.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Spaces Drones evenly from an attachment point to a Disaster
+ *
+ * @details Positions are rounded to whole coordinates, then checked: every
+ *          link must be within the Fleet's range and the last Drone within
+ *          reach of the Disaster. Distances are compared squared in 64 bits
+ *
+ * @param in: fleet
+ *            Fleet the Drones belong to
+ *
+ *            fromX
+ *            x coordinate of the attachment point
+ *
+ *            fromY
+ *            y coordinate of the attachment point
+ *
+ *            xPos
+ *            x coordinate of the Disaster
+ *
+ *            yPos
+ *            y coordinate of the Disaster
+ *
+ *            drones
+ *            Number of Drones to place
+ *
+ *            plan
+ *            Its xPos and yPos are filled with the positions
+ *
+ * @return bool Evidence that the positions form a working relay
+ *
+ * @note O(drones)
+ */
+static bool spaceDrones( const Fleet& fleet, int fromX, int fromY, int xPos,
+                         int yPos, int drones, RelayPlan& plan )
+{
+    int step;
+    int prevX = fromX, prevY = fromY;
+
+    plan.xPos.resize( drones );
+    plan.yPos.resize( drones );
+
+    for( step = 0; step < drones; step++ )
+    {
+        plan.xPos[step] = fromX + lround( (double)( xPos - fromX )
+                                    * ( step + 1 ) / ( drones + 1 ) );
+        plan.yPos[step] = fromY + lround( (double)( yPos - fromY )
+                                    * ( step + 1 ) / ( drones + 1 ) );
+        if( !inRange( fleet, prevX, prevY, plan.xPos[step],
+                      plan.yPos[step] ) )
+        {
+            return false;
+        }
+        prevX = plan.xPos[step];
+        prevY = plan.yPos[step];
+    }
+
+    return inReach( fleet, prevX, prevY, xPos, yPos );
+}
+
+/**
+ * @brief Returns how many new Drones bridge a gap to a Disaster
+ *
+ * @details Starts from the fewest Drones that could span the distance and
+ *          adds one until spaceDrones accepts the rounded positions. With
+ *          more than twice as many Drones as units along the longer axis
+ *          the last Drone rounds onto the Disaster and no link moves more
+ *          than one unit on each axis, so more Drones cannot help. That, or
+ *          the size of the Fleet, is the limit. A range too short for a
+ *          diagonal step fails there
+ *
+ * @param in: fleet
+ *            Fleet the Drones belong to
+ *
+ *            fromX
+ *            x coordinate of the attachment point
+ *
+ *            fromY
+ *            y coordinate of the attachment point
+ *
+ *            xPos
+ *            x coordinate of the Disaster
+ *
+ *            yPos
+ *            y coordinate of the Disaster
+ *
+ *            fromBase
+ *            True when attaching to the base station, which always needs at
+ *            least one Drone for packets to enter
+ *
+ *            plan
+ *            Its xPos and yPos are filled with the positions
+ *
+ * @return int number of Drones, -1 if no number within the limit works
+ *
+ * @note None
+ */
+static int dronesNeeded( const Fleet& fleet, int fromX, int fromY, int xPos,
+                         int yPos, bool fromBase, RelayPlan& plan )
+{
+    int drones = max( 0, (int)ceil( hypot( xPos - fromX, yPos - fromY )
+                                    / ( fleet.range * REACH_MARGIN ) ) - 1 );
+    int limit = (int)min( 2LL * max( abs( xPos - fromX ), abs( yPos - fromY ) )
+                          + 1, (long long)fleet.size );
+
+    if( fromBase )
+    {
+        drones = max( 1, drones );
+    }
+
+    while( drones <= limit )
+    {
+        if( spaceDrones( fleet, fromX, fromY, xPos, yPos, drones, plan ) )
+        {
+            return drones;
+        }
+        drones++;
+    }
+
+    plan.xPos.clear();
+    plan.yPos.clear();
+    return -1;
+}
+
+/**
+ * @brief Returns how many Drones a packet crosses from a Drone to the base
+ *
+ * @details Follows the previous links, which are the route packets take
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            Index of an in flight Drone
+ *
+ * @return int number of Drones, counting the first
+ *
+ * @note O(relay length)
+ */
+static int relayDepth( const Fleet& fleet, int index )
+{
+    int depth = 0;
+
+    //a relay never holds more Drones than the fleet
+    while( index >= 0 && depth < fleet.size )
+    {
+        depth++;
+        index = fleet.previous[index];
+    }
+
+    return depth;
+}
+
+/**
+ * @brief Plans the cheapest relay from the existing network to a point
+ *
+ * @details Every in flight Drone already reaches the base station through
+ *          its relay, so the network is a tree rooted at the base and any of
+ *          its nodes can be attached to. Attachment points are ranked by the
+ *          number of new Drones needed, then by how many Drones a packet
+ *          crosses to reach the Fleet's base, then by index with the base
+ *          first. Only Drones close enough to possibly beat the base station
+ *          are looked at. New Drones are spaced evenly on the straight line from
+ *          the attachment point to the Disaster, see spaceDrones. When no
+ *          attachment point can be bridged within dronesNeeded's limit the
+ *          plan is left empty
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            xPos
+ *            x coordinate of the Disaster
+ *
+ *            yPos
+ *            y coordinate of the Disaster
+ *
+ *            plan
+ *            Filled with the attachment point and new Drone positions
+ *
+ * @return bool Evidence that a relay could be planned
+ *
+ * @note O(findClosest + candidates * relay length)
+ */
+bool planRelay( const Fleet& fleet, int xPos, int yPos, RelayPlan& plan )
+{
+    vector<int>& found = plan.found;
+    int bestDrones = dronesNeeded( fleet, fleet.baseX, fleet.baseY, xPos,
+                                   yPos, true, plan );
+    int bestDepth = 0;
+    int nearest = gridNearest( fleet, xPos, yPos );
+    int member, candidate, drones, depth;
+
+    plan.attach = -1;
+
+    //nothing further than this from the Disaster can need fewer Drones
+    if( nearest >= 0 && bestDrones >= 0 )
+    {
+        gridWithinRadius( fleet, xPos, yPos,
+                          (int)ceil( fleet.range * REACH_MARGIN
+                                     * ( bestDrones + 1 ) ), found );
+    }
+    else if( nearest >= 0 )
+    {
+        gridWithinRadius( fleet, xPos, yPos,
+                          (int)min( 2LL * fleet.mapSize, (long long)INT_MAX ),
+                          found );
+    }
+    else
+    {
+        found.clear();
+    }
+
+    for( member = 0; member < (int)found.size(); member++ )
+    {
+        candidate = found[member];
+        drones = dronesNeeded( fleet, fleet.xPos[candidate],
+                               fleet.yPos[candidate], xPos, yPos, false, plan );
+        if( drones < 0 || ( bestDrones >= 0 && drones > bestDrones ) )
+        {
+            continue;
+        }
+
+        depth = relayDepth( fleet, candidate );
+        if( bestDrones < 0 || drones < bestDrones || depth < bestDepth
+             || ( depth == bestDepth && candidate < plan.attach ) )
+        {
+            plan.attach = candidate;
+            bestDrones = drones;
+            bestDepth = depth;
+        }
+    }
+
+    if( bestDrones < 0 )
+    {
+        plan.hops = -1;
+        return false;
+    }
+
+    plan.hops = bestDepth + bestDrones;
+    if( plan.attach >= 0 )
+    {
+        dronesNeeded( fleet, fleet.xPos[plan.attach], fleet.yPos[plan.attach],
+                      xPos, yPos, false, plan );
+    }
+    else
+    {
+        dronesNeeded( fleet, fleet.baseX, fleet.baseY, xPos, yPos, true, plan );
+    }
+
+    return true;
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
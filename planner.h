@@ -0,0 +1,29 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file planner.h
+ *
+ * @details Header file for the relay planner which provides prototypes for
+ *          choosing where a new relay attaches and where its Drones fly
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef PLANNER_H
+#define PLANNER_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+bool planRelay( const Fleet& fleet, int xPos, int yPos, RelayPlan& plan );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,210 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file pool.cpp
+ *
+ * @details Implementation file for slot pools which provides function
+ *          definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef POOL_CPP
+#define POOL_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "pool.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Empties a pool and fills it with slots that are all in use
+ *
+ * @details Used when the owner's arrays are built or loaded with the given
+ *          number of entries. The peak starts at that number and the growth
+ *          count at zero
+ *
+ * @param in: pool
+ *            Pool to reset
+ *
+ *            slots
+ *            Number of slots, indices 0 to slots - 1
+ *
+ * @return void
+ *
+ * @note O(slots)
+ */
+void poolReset( SlotPool& pool, int slots )
+{
+    pool.live.assign( slots, 1 );
+    pool.freeSlots.clear();
+    pool.freeSlots.reserve( pool.live.capacity() );
+    pool.used = slots;
+    pool.peak = slots;
+    pool.growths = 0;
+}
+
+/**
+ * @brief Makes room for a number of slots without allocating later
+ *
+ * @details The owner should reserve its own arrays to the same number
+ *
+ * @param in: pool
+ *            Pool to reserve
+ *
+ *            slots
+ *            Number of slots the pool can hold before it allocates
+ *
+ * @return void
+ *
+ * @note None
+ */
+void poolReserve( SlotPool& pool, int slots )
+{
+    pool.live.reserve( slots );
+    pool.freeSlots.reserve( slots );
+}
+
+/**
+ * @brief Returns the slot poolAcquire would hand out next
+ *
+ * @param in: pool
+ *            Pool to look at
+ *
+ * @return int index of the next slot, equal to the number of slots when a
+ *         new one would be added
+ *
+ * @note O(1)
+ */
+int poolPeek( const SlotPool& pool )
+{
+    if( !pool.freeSlots.empty() )
+    {
+        return pool.freeSlots.back();
+    }
+
+    return pool.live.size();
+}
+
+/**
+ * @brief Hands out a slot, the most recently released one first
+ *
+ * @details A new slot is only added at the end when the free list is
+ *          empty, and the owner then has to grow its arrays to match. Adding
+ *          a slot past the reserved capacity counts as a growth, and the free
+ *          list is grown with it so releasing never allocates
+ *
+ * @param in: pool
+ *            Pool to take a slot from
+ *
+ * @return int index of the slot
+ *
+ * @note O(1) amortized
+ */
+int poolAcquire( SlotPool& pool )
+{
+    int index;
+
+    if( !pool.freeSlots.empty() )
+    {
+        index = pool.freeSlots.back();
+        pool.freeSlots.pop_back();
+        pool.live[index] = 1;
+    }
+    else
+    {
+        index = pool.live.size();
+        if( pool.live.size() == pool.live.capacity() )
+        {
+            pool.growths++;
+        }
+        pool.live.push_back( 1 );
+        pool.freeSlots.reserve( pool.live.capacity() );
+    }
+
+    pool.used++;
+    pool.peak = max( pool.peak, pool.used );
+
+    return index;
+}
+
+/**
+ * @brief Puts a slot back on the free list
+ *
+ * @param in: pool
+ *            Pool the slot belongs to
+ *
+ *            index
+ *            Index of the slot
+ *
+ * @return bool Evidence that the slot was in use
+ *
+ * @note O(1)
+ */
+bool poolRelease( SlotPool& pool, int index )
+{
+    if( !poolLive( pool, index ) )
+    {
+        return false;
+    }
+
+    pool.live[index] = 0;
+    pool.freeSlots.push_back( index );
+    pool.used--;
+
+    return true;
+}
+
+/**
+ * @brief Decides whether a slot is in use
+ *
+ * @param in: pool
+ *            Pool the slot belongs to
+ *
+ *            index
+ *            Index of the slot, any value
+ *
+ * @return bool True if the slot has been handed out and not released
+ *
+ * @note O(1)
+ */
+bool poolLive( const SlotPool& pool, int index )
+{
+    return index >= 0 && index < (int)pool.live.size() && pool.live[index];
+}
+
+/**
+ * @brief Prints one line of occupancy stats for a pool
+ *
+ * @param in: out
+ *            Stream to print to
+ *
+ *            name
+ *            What the slots hold
+ *
+ *            pool
+ *            Pool to report
+ *
+ * @return void
+ *
+ * @note None
+ */
+void poolReport( ostream& out, const char* name, const SlotPool& pool )
+{
+    out << name << ": " << pool.used << " of " << pool.live.size()
+        << " slots in use, peak " << pool.peak << ", "
+        << pool.freeSlots.size() << " free, capacity " << pool.live.capacity()
+        << ", " << pool.growths
+        << ( pool.growths == 1 ? " growth" : " growths" ) << '\n';
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,37 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file pool.h
+ *
+ * @details Header file for slot pools which provides prototypes for handing
+ *          out stable indices from a free list and reporting how full the
+ *          pools are
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef POOL_H
+#define POOL_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+void poolReset( SlotPool& pool, int slots );
+void poolReserve( SlotPool& pool, int slots );
+int poolPeek( const SlotPool& pool );
+int poolAcquire( SlotPool& pool );
+bool poolRelease( SlotPool& pool, int index );
+bool poolLive( const SlotPool& pool, int index );
+void poolReport( ostream& out, const char* name, const SlotPool& pool );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
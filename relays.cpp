@@ -0,0 +1,274 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file relays.cpp
+ *
+ * @details Implementation file for the relay registry which provides
+ *          function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef RELAYS_CPP
+#define RELAYS_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "relays.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Empties the registry entry of a Disaster, adding it if needed
+ *
+ * @details An empty entry means the Disaster is covered by another relay
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            disNum
+ *            Disaster number of the entry
+ *
+ * @return void
+ *
+ * @note Used by generateRelay before any Drone is dispatched
+ */
+void relayReset( Fleet& fleet, int disNum )
+{
+    Relay empty = { -1, -1, 0, 0, -1, -1 };
+
+    if( (int)fleet.relays.size() <= disNum )
+    {
+        fleet.relays.resize( disNum + 1, empty );
+    }
+
+    fleet.relays[disNum] = empty;
+}
+
+/**
+ * @brief Adds a Drone to the Disaster end of a relay
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            disNum
+ *            Disaster number of the relay
+ *
+ *            index
+ *            Index of the Drone, already in flight with its battery current
+ *
+ * @return void
+ *
+ * @note O(1)
+ */
+void relayAppend( Fleet& fleet, int disNum, int index )
+{
+    Relay& relay = fleet.relays[disNum];
+
+    if( relay.head < 0 )
+    {
+        relay.head = index;
+    }
+
+    relay.tail = index;
+    relay.length++;
+    relay.batteryKey += fleet.battery[index] + fleet.clock;
+}
+
+/**
+ * @brief Swaps a Drone in the registry for the Drone replacing it
+ *
+ * @details The relay keeps its length, head and tail follow the swap
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            Index of the Drone being replaced, before it is reset
+ *
+ *            newIndex
+ *            Index of the replacement, with its battery current
+ *
+ * @return void
+ *
+ * @note O(1)
+ */
+void relayReplace( Fleet& fleet, int index, int newIndex )
+{
+    int disNum = fleet.disNum[index];
+
+    if( disNum < 0 || disNum >= (int)fleet.relays.size() )
+    {
+        return;
+    }
+
+    Relay& relay = fleet.relays[disNum];
+
+    if( relay.head == index )
+    {
+        relay.head = newIndex;
+    }
+
+    if( relay.tail == index )
+    {
+        relay.tail = newIndex;
+    }
+
+    relay.batteryKey += fleet.battery[newIndex] - fleet.battery[index];
+}
+
+/**
+ * @brief Takes a Drone out of the registry entry of its relay
+ *
+ * @details The length and battery total drop by the Drone, and head and
+ *          tail move to its neighbor in the same relay. An entry left with
+ *          no Drone means the Disaster is covered by another relay
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            Index of the Drone, with its battery current and its links not
+ *            yet changed
+ *
+ * @return void
+ *
+ * @note O(1)
+ */
+void relayRemove( Fleet& fleet, int index )
+{
+    int disNum = fleet.disNum[index];
+    int neighbor;
+
+    if( disNum < 0 || disNum >= (int)fleet.relays.size() )
+    {
+        return;
+    }
+
+    Relay& relay = fleet.relays[disNum];
+
+    if( relay.head == index )
+    {
+        neighbor = fleet.next[index];
+        relay.head = neighbor >= 0 && fleet.disNum[neighbor] == disNum
+                     ? neighbor : -1;
+    }
+
+    if( relay.tail == index )
+    {
+        neighbor = fleet.previous[index];
+        relay.tail = neighbor >= 0 && fleet.disNum[neighbor] == disNum
+                     ? neighbor : -1;
+    }
+
+    relay.length--;
+    relay.batteryKey -= fleet.battery[index] + fleet.clock;
+}
+
+/**
+ * @brief Takes charge from an in flight Drone and its relay total
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            Index of the Drone
+ *
+ *            amount
+ *            Percent of battery used
+ *
+ * @return void
+ *
+ * @note O(1)
+ */
+void relayDrain( Fleet& fleet, int index, int amount )
+{
+    int disNum = fleet.disNum[index];
+
+    fleet.battery[index] -= amount;
+
+    if( disNum >= 0 && disNum < (int)fleet.relays.size() )
+    {
+        fleet.relays[disNum].batteryKey -= amount;
+    }
+}
+
+/**
+ * @brief Returns the total battery of a relay
+ *
+ * @details Correct at any clock value, even while advanceTime leaves
+ *          individual batteries out of date
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            disNum
+ *            Disaster number of the relay
+ *
+ * @return long Sum of the battery percent of every Drone in the relay
+ *
+ * @note O(1)
+ */
+long relayBattery( const Fleet& fleet, int disNum )
+{
+    const Relay& relay = fleet.relays[disNum];
+
+    return relay.batteryKey - (long)relay.length * fleet.clock;
+}
+
+/**
+ * @brief Records that an established relay has no Drone of its own
+ *
+ * @details Its Disaster is covered by another relay's Drone, which has to
+ *          stay in flight until the Disaster is resolved, see teardownRelay
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            disNum
+ *            Disaster number of the relay, with its position set
+ *
+ * @return void
+ *
+ * @note O(1)
+ */
+void relayShare( Fleet& fleet, int disNum )
+{
+    fleet.shared.push_back( disNum );
+}
+
+/**
+ * @brief Forgets a relay recorded by relayShare
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            disNum
+ *            Disaster number of the relay
+ *
+ * @return void
+ *
+ * @note O(shared relays)
+ */
+void relayUnshare( Fleet& fleet, int disNum )
+{
+    int member;
+
+    for( member = 0; member < (int)fleet.shared.size(); member++ )
+    {
+        if( fleet.shared[member] == disNum )
+        {
+            fleet.shared[member] = fleet.shared.back();
+            fleet.shared.pop_back();
+            return;
+        }
+    }
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,36 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file relays.h
+ *
+ * @details Header file for the relay registry which provides prototypes for
+ *          tracking the relay of every Disaster
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef RELAYS_H
+#define RELAYS_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+void relayReset( Fleet& fleet, int disNum );
+void relayAppend( Fleet& fleet, int disNum, int index );
+void relayReplace( Fleet& fleet, int index, int newIndex );
+void relayRemove( Fleet& fleet, int index );
+void relayDrain( Fleet& fleet, int index, int amount );
+long relayBattery( const Fleet& fleet, int disNum );
+void relayShare( Fleet& fleet, int disNum );
+void relayUnshare( Fleet& fleet, int disNum );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
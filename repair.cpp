@@ -0,0 +1,293 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file repair.cpp
+ *
+ * @details Implementation file for the relay repair engine which provides
+ *          function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef REPAIR_CPP
+#define REPAIR_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "repair.h"
+#include "idlequeue.h"
+#include "spatialgrid.h"
+#include "pipeline.h"
+#include "relays.h"
+#include "telemetry.h"
+#include "simulator.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Returns how many Drones a packet crosses from a Drone to the base,
+ *        unless its route passes a given Drone
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            Index of an in flight Drone
+ *
+ *            avoid
+ *            Drone the route must not pass
+ *
+ * @return int number of Drones counting the first, -1 if the route passes
+ *         avoid
+ *
+ * @note O(relay length)
+ */
+static int routeDepth( const Fleet& fleet, int index, int avoid )
+{
+    int depth = 0;
+
+    //a route never holds more Drones than the fleet
+    while( index >= 0 && depth < fleet.size )
+    {
+        if( index == avoid )
+        {
+            return -1;
+        }
+
+        depth++;
+        index = fleet.previous[index];
+    }
+
+    return depth;
+}
+
+/**
+ * @brief Picks the Drone a child of a retiring Drone should hang off
+ *
+ * @details The child of a Drone in the middle of a relay has to reach the
+ *          retiring Drone's own previous Drone, or the relay would split in
+ *          two. Any other child starts a relay, or carries on the relay of a
+ *          retiring head, so it can hang off any in flight Drone or base
+ *          station it can link to, see inRange, whose route does not pass
+ *          the retiring Drone. Those are ranked by Drones to the base, then
+ *          distance, then index with the base first
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            child
+ *            Drone whose previous Drone is retiring
+ *
+ *            retiring
+ *            Drone being retired
+ *
+ *            nearby
+ *            Every in flight Drone that could be in reach of child
+ *
+ *            parent
+ *            Set to the chosen Drone, -1 for the base station
+ *
+ * @return bool True if any Drone or the base station is in reach
+ *
+ * @note O(nearby * relay length)
+ */
+static bool chooseParent( const Fleet& fleet, int child, int retiring,
+                          const vector<int>& nearby, int& parent )
+{
+    int upstream = fleet.previous[retiring];
+    int bestDepth = -1;
+    long long bestDist = 0;
+    long long dist;
+    int member, candidate, depth;
+
+    if( !fleet.firstDrone[retiring] && child == fleet.next[retiring] )
+    {
+        parent = upstream;
+        return inRange( fleet, fleet.xPos[child], fleet.yPos[child],
+                        fleet.xPos[upstream], fleet.yPos[upstream] );
+    }
+
+    if( inRange( fleet, fleet.xPos[child], fleet.yPos[child], fleet.baseX,
+                 fleet.baseY ) )
+    {
+        parent = -1;
+        return true;
+    }
+
+    for( member = 0; member < (int)nearby.size(); member++ )
+    {
+        candidate = nearby[member];
+        if( candidate == retiring || candidate == child
+             || !inRange( fleet, fleet.xPos[child], fleet.yPos[child],
+                          fleet.xPos[candidate], fleet.yPos[candidate] ) )
+        {
+            continue;
+        }
+
+        depth = routeDepth( fleet, candidate, retiring );
+        if( depth < 0 )
+        {
+            continue;
+        }
+
+        dist = distSquared( fleet.xPos[child], fleet.yPos[child],
+                            fleet.xPos[candidate], fleet.yPos[candidate] );
+        if( bestDepth < 0 || depth < bestDepth
+             || ( depth == bestDepth && ( dist < bestDist
+                       || ( dist == bestDist && candidate < parent ) ) ) )
+        {
+            parent = candidate;
+            bestDepth = depth;
+            bestDist = dist;
+        }
+    }
+
+    return bestDepth >= 0;
+}
+
+/**
+ * @brief Keeps a relay connected without a Drone that could not be replaced
+ *
+ * @details Only the Drones around the failing one are touched. Its children,
+ *          the next Drone of its relay and the heads of relays attached to
+ *          it, are found with one grid query, and each is given a new
+ *          Drone to hang off with chooseParent: a mid relay child skips the
+ *          failing Drone, which shortens the chain, and any other child may
+ *          reroute through a neighboring relay, which merges the two. Every
+ *          Disaster the failing Drone is in reach of must stay in reach of
+ *          another Drone. If all of that works out the Drone is taken out of
+ *          its relay and returns to the base station to charge, and packets
+ *          queued at it move on to its previous Drone, otherwise nothing
+ *          changes
+ *
+ * @param in: index
+ *            Index of the in flight Drone that could not be replaced, with
+ *            its battery current
+ *
+ *            fleet
+ *            Fleet of all Drones
+ *
+ *            currentTime
+ *            Needed for reference when printing repair information
+ *
+ * @return bool Evidence that the Drone was retired and its relay repaired
+ *
+ * @note O(nearby * relay length + disasters)
+ */
+bool repairRelay( const int index, Fleet& fleet, const int currentTime )
+{
+    vector<int>& nearby = fleet.scratch.nearby;
+    vector<int>& children = fleet.scratch.children;
+    vector<int>& parents = fleet.scratch.parents;
+    int upstream = fleet.previous[index];
+    int downstream = fleet.next[index];
+    int disNum = fleet.disNum[index];
+    int radius = (int)min( 2LL * fleet.range, 2LL * fleet.mapSize );
+    int member, parent, relay;
+    bool covered;
+
+    //children are within range of index, their new parents within range of them
+    gridWithinRadius( fleet, fleet.xPos[index], fleet.yPos[index], radius,
+                      nearby );
+    children.clear();
+    parents.clear();
+
+    for( member = 0; member < (int)nearby.size(); member++ )
+    {
+        if( fleet.previous[nearby[member]] == index )
+        {
+            if( !chooseParent( fleet, nearby[member], index, nearby, parent ) )
+            {
+                return false;
+            }
+
+            children.push_back( nearby[member] );
+            parents.push_back( parent );
+        }
+    }
+
+    for( relay = 0; relay < (int)fleet.relays.size(); relay++ )
+    {
+        if( fleet.relays[relay].xPos < 0
+             || !inReach( fleet, fleet.xPos[index], fleet.yPos[index],
+                          fleet.relays[relay].xPos, fleet.relays[relay].yPos ) )
+        {
+            continue;
+        }
+
+        covered = false;
+        for( member = 0; member < (int)nearby.size() && !covered; member++ )
+        {
+            covered = nearby[member] != index
+                      && inReach( fleet, fleet.xPos[nearby[member]],
+                                  fleet.yPos[nearby[member]],
+                                  fleet.relays[relay].xPos,
+                                  fleet.relays[relay].yPos );
+        }
+
+        if( !covered )
+        {
+            return false;
+        }
+    }
+
+    logEvent( fleet, EVENT_RELAY_REPAIRED, index, disNum, fleet.xPos[index],
+              fleet.yPos[index] );
+    pipelineRetire( fleet, index, upstream );
+    relayRemove( fleet, index );
+    if( disNum >= 0 && disNum < (int)fleet.relays.size()
+         && fleet.relays[disNum].length == 0 )
+    {
+        relayShare( fleet, disNum );
+    }
+
+    for( member = 0; member < (int)children.size(); member++ )
+    {
+        fleet.previous[children[member]] = parents[member];
+        if( children[member] == downstream && fleet.firstDrone[index] )
+        {
+            fleet.firstDrone[downstream] = true;
+        }
+    }
+
+    if( upstream >= 0 && fleet.next[upstream] == index )
+    {
+        fleet.next[upstream] = downstream;
+    }
+
+    gridRemove( fleet, index );
+    fleet.inFlight[index] = false;
+    fleet.dronesUsed--;
+    fleet.xPos[index] = fleet.baseX;
+    fleet.yPos[index] = fleet.baseY;
+    fleet.disNum[index] = -1;
+    fleet.firstDrone[index] = false;
+    fleet.previous[index] = -1;
+    fleet.next[index] = -1;
+    idleInsert( fleet, index );
+    fleet.repairs++;
+
+    if( fleet.console )
+    {
+        cout << "Drone #" << index << " retired, relay repaired without it";
+
+        if( currentTime >= 0 )
+        {
+            cout << " at time " << currentTime;
+        }
+
+        cout << '\n';
+    }
+
+    return true;
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
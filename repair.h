@@ -0,0 +1,30 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file repair.h
+ *
+ * @details Header file for the relay repair engine which provides
+ *          prototypes for keeping relays connected when a Drone cannot be
+ *          replaced
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef REPAIR_H
+#define REPAIR_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+bool repairRelay( const int index, Fleet& fleet, const int currentTime );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,133 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file rng.cpp
+ *
+ * @details Implementation file for the random number generator which
+ *          provides function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef RNG_CPP
+#define RNG_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include "rng.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Rotates a 64 bit value left
+ *
+ * @param in: value
+ *            Value to rotate
+ *
+ *            bits
+ *            Number of bits, 1-63
+ *
+ * @return uint64_t rotated value
+ *
+ * @note None
+ */
+static inline uint64_t rotateLeft( uint64_t value, int bits )
+{
+    return ( value << bits ) | ( value >> ( 64 - bits ) );
+}
+
+/**
+ * @brief Starts a generator from a 64 bit seed
+ *
+ * @details The four state words are filled with splitmix64, so nearby seeds
+ *          such as seed and seed + 1 give unrelated streams and the state is
+ *          never all zero
+ *
+ * @param in: rng
+ *            Generator to seed
+ *
+ *            seed
+ *            Any value, the same seed gives the same stream
+ *
+ * @return void
+ *
+ * @note None
+ */
+void rngSeed( Rng& rng, uint64_t seed )
+{
+    uint64_t mixed;
+    int word;
+
+    for( word = 0; word < 4; word++ )
+    {
+        seed += 0x9e3779b97f4a7c15ULL;
+        mixed = seed;
+        mixed = ( mixed ^ ( mixed >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+        mixed = ( mixed ^ ( mixed >> 27 ) ) * 0x94d049bb133111ebULL;
+        rng.state[word] = mixed ^ ( mixed >> 31 );
+    }
+}
+
+/**
+ * @brief Draws the next 64 random bits
+ *
+ * @details xoshiro256** by Blackman and Vigna: a few shifts, rotates and
+ *          one multiply per draw, with a period of 2^256 - 1
+ *
+ * @param in: rng
+ *            Generator to draw from
+ *
+ * @return uint64_t random bits
+ *
+ * @note None
+ */
+uint64_t rngNext( Rng& rng )
+{
+    uint64_t result = rotateLeft( rng.state[1] * 5, 7 ) * 9;
+    uint64_t shifted = rng.state[1] << 17;
+
+    rng.state[2] ^= rng.state[0];
+    rng.state[3] ^= rng.state[1];
+    rng.state[1] ^= rng.state[2];
+    rng.state[0] ^= rng.state[3];
+    rng.state[2] ^= shifted;
+    rng.state[3] = rotateLeft( rng.state[3], 45 );
+
+    return result;
+}
+
+/**
+ * @brief Draws a whole number between low and high, both included
+ *
+ * @details The top 32 bits of a draw are scaled onto the range with a
+ *          multiply and shift instead of a division. The bias this leaves
+ *          is below span / 2^32, far too small to matter for map positions
+ *          or batteries
+ *
+ * @param in: rng
+ *            Generator to draw from
+ *
+ *            low
+ *            Smallest value returned
+ *
+ *            high
+ *            Largest value returned, at least low
+ *
+ * @return int value in [low, high]
+ *
+ * @note None
+ */
+int rngRange( Rng& rng, int low, int high )
+{
+    uint64_t span = (uint64_t)( (int64_t)high - low ) + 1;
+
+    return (int)( low + (int64_t)( ( ( rngNext( rng ) >> 32 ) * span ) >> 32 ) );
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,31 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file rng.h
+ *
+ * @details Header file for the random number generator which provides
+ *          prototypes for seeding and drawing from a per Fleet generator
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef RNG_H
+#define RNG_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include "structs.h"
+
+using namespace std;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+void rngSeed( Rng& rng, uint64_t seed );
+uint64_t rngNext( Rng& rng );
+int rngRange( Rng& rng, int low, int high );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,477 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file scenario.cpp
+ *
+ * @details Implementation file for batch mode which provides function
+ *          definitions and documentation
+ *
+ * @Note Scenario commands, one per line, # starts a comment:
+ *           disaster <x> <y>   create a disaster and its relay
+ *           resolve <number>   resolve a disaster and land its relay
+ *           advance <minutes>  simulate minutes passing
+ *           packet <x> <y>     send a packet from (x,y)
+ *           packets <count>    send count packets as one batch, cycling
+ *                              over the active disaster sites, and print
+ *                              stats
+ *           pipeline <hop ticks> <queue capacity> <send rate>
+ *                    <ticks per minute> <packets per percent>
+ *                              empty the packet pipelines and change their
+ *                              settings
+ *           traffic <per minute> <minutes>
+ *                              send packets a hop at a time from the active
+ *                              disaster sites while the clock runs, and
+ *                              print pipeline stats
+ *           consolidate        merge relays onto a shared backbone now
+ *           commission <base> <count>
+ *                              put count charged drones into service at a
+ *                              base station
+ *           lose <base> <drone>
+ *                              take a drone of a base station out of
+ *                              service, replacing it if it is in flight
+ *           reserve <drones> <disasters>
+ *                              set aside room so runs within those numbers
+ *                              do not allocate
+ *           relays             print relay network information
+ *           map                print relay map
+ *           save <file>        write a snapshot of the simulator state,
+ *                              only with a single base station
+ *           load <file>        replace the simulator state with a snapshot,
+ *                              only with a single base station
+ *           dump               print a summary of the simulator state
+ *           pools              print drone, disaster and relay occupancy
+ *           stats              print the instrumentation summary
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef SCENARIO_CPP
+#define SCENARIO_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include "scenario.h"
+#include "pool.h"
+#include "instrument.h"
+#include "packets.h"
+#include "pipeline.h"
+#include "relays.h"
+#include "consolidate.h"
+#include "bases.h"
+#include "snapshot.h"
+#include "telemetry.h"
+#include "simulator.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Reads a pair of map coordinates for a scenario command
+ *
+ * @details Coordinates must be between 1 and mapSize, the same range the
+ *          interactive prompts accept
+ *
+ * @param in: in
+ *            Scenario stream positioned after the command word
+ *
+ *            mapSize
+ *            Largest coordinate on the map
+ *
+ *            xPos
+ *            Filled with the x coordinate
+ *
+ *            yPos
+ *            Filled with the y coordinate
+ *
+ * @return bool Evidence of two valid coordinates
+ *
+ * @note None
+ */
+static bool readPosition( istream& in, int mapSize, int& xPos, int& yPos )
+{
+    if( !( in >> xPos >> yPos ) )
+    {
+        return false;
+    }
+
+    return xPos >= 1 && xPos <= mapSize && yPos >= 1 && yPos <= mapSize;
+}
+
+/**
+ * @brief Runs every command in a scenario stream without prompting
+ *
+ * @details Commands are read word by word straight from the stream, so a
+ *          long scenario costs no per line allocation. Output goes through
+ *          the same functions as the menu and is only flushed when the
+ *          stream buffer fills. A command that cannot be run is reported on
+ *          cerr with its number and the rest of its line is skipped
+ *
+ * @param in: in
+ *            Stream of scenario commands
+ *
+ *            network
+ *            Fleets of all base stations
+ *
+ *            disasterSet
+ *            Vector containing all disaster data
+ *
+ * @return bool Evidence that every command was valid
+ *
+ * @note See the file notes for the command list
+ */
+bool runScenario( istream& in, BaseNetwork& network,
+                  vector<Disaster>& disasterSet )
+{
+    string command, path;
+    int commandCount = 0;
+    int xPos, yPos, minutes, count, packet, workers, base, disNum, disIndex;
+    int drone, drones, disasters, hopTicks, capacity, rate, ticks, perPercent;
+    vector<int> packetXPos, packetYPos, sites;
+    PacketBatch batch;
+    MapFrame frame;
+    PacketPipeline settings;
+    vector<PacketPipeline> pipelines;
+    bool valid = true;
+    bool commandValid;
+    bool console;
+    Telemetry* telemetry;
+
+    pipelineReset( settings );
+
+    while( in >> command )
+    {
+        if( command[0] == '#' )
+        {
+            in.ignore( numeric_limits<streamsize>::max(), '\n' );
+            continue;
+        }
+
+        commandCount++;
+        commandValid = true;
+
+        if( command == "disaster" )
+        {
+            commandValid = readPosition( in, network.partitions[0].mapSize,
+                                         xPos, yPos );
+            if( commandValid )
+            {
+                addDisaster( network, disasterSet, xPos, yPos );
+            }
+        }
+        else if( command == "resolve" )
+        {
+            commandValid = ( in >> disNum )
+                           && resolveDisaster( network, disasterSet, disNum );
+        }
+        else if( command == "advance" )
+        {
+            commandValid = ( in >> minutes ) && minutes >= 0;
+            if( commandValid )
+            {
+                networkAdvance( network, minutes );
+            }
+        }
+        else if( command == "packet" )
+        {
+            commandValid = readPosition( in, network.partitions[0].mapSize,
+                                         xPos, yPos );
+            base = commandValid ? networkRoute( network, xPos, yPos ) : -1;
+            if( commandValid && ( base < 0 || !sendPacketFrom(
+                            network.partitions[base], xPos, yPos ) ) )
+            {
+                cout << '\n'
+                     << "Unable to connect to fleet from given coordinates" << '\n';
+            }
+        }
+        else if( command == "packets" )
+        {
+            sites.clear();
+            for( disIndex = 0; disIndex < (int)disasterSet.size(); disIndex++ )
+            {
+                if( disasterSet[disIndex].disNum >= 0 )
+                {
+                    sites.push_back( disIndex );
+                }
+            }
+
+            commandValid = ( in >> count ) && count >= 0 && !sites.empty();
+            if( commandValid )
+            {
+                packetXPos.resize( count );
+                packetYPos.resize( count );
+                for( packet = 0; packet < count; packet++ )
+                {
+                    disIndex = sites[packet % sites.size()];
+                    packetXPos[packet] = disasterSet[disIndex].xPos;
+                    packetYPos[packet] = disasterSet[disIndex].yPos;
+                }
+
+                resetPacketBatch( batch );
+                networkSendBatch( network, packetXPos.data(),
+                                  packetYPos.data(), count, batch );
+                printPacketStats( cout, batch );
+            }
+        }
+        else if( command == "pipeline" )
+        {
+            commandValid = ( in >> hopTicks >> capacity >> rate >> ticks
+                                >> perPercent ) && hopTicks >= 1
+                           && capacity >= 1 && rate >= 1 && ticks >= 1
+                           && perPercent >= 0;
+            if( commandValid )
+            {
+                settings.hopTicks = hopTicks;
+                settings.queueCapacity = capacity;
+                settings.sendRate = rate;
+                settings.ticksPerMinute = ticks;
+                settings.packetsPerPercent = perPercent;
+                pipelines.assign( network.partitions.size(), settings );
+            }
+        }
+        else if( command == "traffic" )
+        {
+            if( pipelines.empty() )
+            {
+                pipelines.assign( network.partitions.size(), settings );
+            }
+
+            commandValid = ( in >> count >> minutes ) && count >= 0
+                           && minutes >= 0
+                           && networkTraffic( network, disasterSet, count,
+                                              minutes, pipelines );
+            for( base = 0; commandValid && base < (int)pipelines.size(); base++ )
+            {
+                if( pipelines.size() > 1 )
+                {
+                    cout << '\n' << "Base #" << base;
+                }
+                printPipelineStats( cout, pipelines[base] );
+            }
+        }
+        else if( command == "consolidate" )
+        {
+            for( base = 0; base < (int)network.partitions.size(); base++ )
+            {
+                consolidateRelays( network.partitions[base], -1 );
+            }
+        }
+        else if( command == "commission" )
+        {
+            commandValid = ( in >> base >> count ) && base >= 0
+                           && base < (int)network.partitions.size()
+                           && count >= 0;
+            for( drone = 0; commandValid && drone < count; drone++ )
+            {
+                addDrone( network.partitions[base] );
+            }
+        }
+        else if( command == "lose" )
+        {
+            commandValid = ( in >> base >> drone ) && base >= 0
+                           && base < (int)network.partitions.size()
+                           && loseDrone( drone, network.partitions[base], -1 );
+        }
+        else if( command == "reserve" )
+        {
+            commandValid = ( in >> drones >> disasters ) && drones >= 0
+                           && disasters >= 0;
+            if( commandValid )
+            {
+                networkReserve( network, disasterSet, drones, disasters );
+            }
+        }
+        else if( command == "relays" )
+        {
+            displayRelay( network, disasterSet );
+        }
+        else if( command == "map" )
+        {
+            printMap( network, disasterSet, frame );
+        }
+        else if( command == "save" )
+        {
+            commandValid = ( in >> path ) && network.partitions.size() == 1
+                            && saveSnapshot( path.c_str(), network.partitions[0],
+                                             disasterSet );
+        }
+        else if( command == "load" )
+        {
+            commandValid = ( in >> path ) && network.partitions.size() == 1;
+            if( commandValid )
+            {
+                Fleet& fleet = network.partitions[0];
+                
+                //run settings are not part of the state
+                workers = fleet.workers;
+                console = fleet.console;
+                telemetry = fleet.telemetry;
+                commandValid = loadSnapshot( path.c_str(), fleet, disasterSet );
+                if( commandValid )
+                {
+                    networkFreeDisasters( network, disasterSet );
+
+                    //queued packets belong to Drones of the old state
+                    pipelines.assign( pipelines.size(), settings );
+                }
+                fleet.workers = workers;
+                fleet.console = console;
+                fleet.telemetry = telemetry;
+            }
+        }
+        else if( command == "dump" )
+        {
+            dumpState( network, disasterSet );
+        }
+        else if( command == "pools" )
+        {
+            dumpPools( network );
+        }
+        else if( command == "stats" )
+        {
+            instrumentReport( cout );
+        }
+        else
+        {
+            commandValid = false;
+        }
+
+        if( !commandValid )
+        {
+            cerr << "Scenario command #" << commandCount << " (" << command
+                 << ") is invalid, skipping it" << '\n';
+            in.clear();
+            in.ignore( numeric_limits<streamsize>::max(), '\n' );
+            valid = false;
+        }
+    }
+
+    return valid;
+}
+
+/**
+ * @brief Prints a summary of the simulator state followed by every relay
+ *
+ * @details Reports the clock, how many Drones in service are in flight,
+ *          how many Disasters are active and the average battery of the
+ *          relay Drones from the relay registries, then calls displayRelay.
+ *          With more than one base station each is listed with its own Drone
+ *          counts
+ *
+ * @param in: network
+ *            Fleets of all base stations
+ *
+ *            disasterSet
+ *            Vector containing all disaster data
+ *
+ * @return void
+ *
+ * @note None
+ */
+void dumpState( const BaseNetwork& network,
+                const vector<Disaster>& disasterSet )
+{
+    int disIndex, base;
+    long airborne = 0;
+    long drones = 0;
+    long relayDrones = 0;
+    long relayCharge = 0;
+    long active = 0;
+
+    for( base = 0; base < (int)network.partitions.size(); base++ )
+    {
+        const Fleet& fleet = network.partitions[base];
+
+        airborne += fleet.airborne.count;
+        drones += fleet.drones.used;
+        for( disIndex = 0; disIndex < (int)fleet.relays.size(); disIndex++ )
+        {
+            relayDrones += fleet.relays[disIndex].length;
+            relayCharge += relayBattery( fleet, disIndex );
+        }
+    }
+
+    for( disIndex = 0; disIndex < (int)disasterSet.size(); disIndex++ )
+    {
+        if( disasterSet[disIndex].disNum >= 0 )
+        {
+            active++;
+        }
+    }
+
+    cout << '\n'
+         << "Time: " << network.partitions[0].clock << " minutes" << '\n'
+         << "Drones in flight: " << airborne << " of " << drones << '\n'
+         << "Disasters: " << active << '\n';
+
+    if( network.partitions.size() > 1 )
+    {
+        for( base = 0; base < (int)network.partitions.size(); base++ )
+        {
+            const Fleet& fleet = network.partitions[base];
+
+            cout << "Base #" << base << " at " << fleet.baseX << ", "
+                 << fleet.baseY << ": " << fleet.airborne.count << " of "
+                 << fleet.drones.used << " in flight, " << fleet.reserve
+                 << "% reserve" << '\n';
+        }
+    }
+
+    if( relayDrones > 0 )
+    {
+        cout << "Average relay battery: " << relayCharge / relayDrones
+             << "%" << '\n';
+    }
+
+    displayRelay( network, disasterSet );
+}
+
+/**
+ * @brief Prints how full the pools and relay registries of a network are
+ *
+ * @details One line for the Disaster numbers, then for each base station
+ *          its drones pool and how many entries of its relay registry serve
+ *          an active Disaster. See poolReport
+ *
+ * @param in: network
+ *            Fleets of all base stations
+ *
+ * @return void
+ *
+ * @note O(partitions * disasters)
+ */
+void dumpPools( const BaseNetwork& network )
+{
+    int base, disNum;
+    int established;
+
+    cout << '\n';
+    poolReport( cout, "Disasters", network.disasters );
+
+    for( base = 0; base < (int)network.partitions.size(); base++ )
+    {
+        const Fleet& fleet = network.partitions[base];
+
+        established = 0;
+        for( disNum = 0; disNum < (int)fleet.relays.size(); disNum++ )
+        {
+            if( fleet.relays[disNum].xPos >= 0 )
+            {
+                established++;
+            }
+        }
+
+        cout << "Base #" << base << " ";
+        poolReport( cout, "drones", fleet.drones );
+        cout << "Base #" << base << " relays: " << established << " of "
+             << fleet.relays.size() << " entries established, capacity "
+             << fleet.relays.capacity() << '\n';
+    }
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,34 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file scenario.h
+ *
+ * @details Header file for batch mode which provides prototypes for running
+ *          a stream of simulator commands without prompts
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+bool runScenario( istream& in, BaseNetwork& network,
+                  vector<Disaster>& disasterSet );
+void dumpState( const BaseNetwork& network,
+                const vector<Disaster>& disasterSet );
+void dumpPools( const BaseNetwork& network );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,541 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file simulation.cpp
+ *
+ * @details Implementation file for the Simulation engine object which
+ *          provides function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef SIMULATION_CPP
+#define SIMULATION_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "simulation.h"
+#include "scenario.h"
+#include "pipeline.h"
+#include "bases.h"
+#include "snapshot.h"
+#include "telemetry.h"
+#include "simulator.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Creates a Simulation with no base station and no Disaster
+ *
+ * @details Add at least one base station with addBase before anything else
+ *
+ * @param in: None
+ *
+ * @note None
+ */
+Simulation::Simulation()
+{
+    networkClear( network );
+}
+
+/**
+ * @brief Adds a Command and Control Center with a Fleet of its own
+ *
+ * @param in: xPos
+ *            x coordinate of the base station
+ *
+ *            yPos
+ *            y coordinate of the base station
+ *
+ *            drones
+ *            Number of Drones in the base station's Fleet
+ *
+ *            reserve
+ *            Percent of the Drones kept at the base station
+ *
+ *            seed
+ *            Seed of the Fleet's random number generator
+ *
+ * @return void
+ *
+ * @note See networkAddBase
+ */
+void Simulation::addBase( int xPos, int yPos, int drones, int reserve,
+                          uint64_t seed )
+{
+    networkAddBase( network, xPos, yPos, drones, reserve, seed );
+}
+
+/**
+ * @brief Sets the map size and Drone range of every base station
+ *
+ * @param in: mapSize
+ *            Map spans 0-mapSize on both axes
+ *
+ *            range
+ *            Longest link between two Drones, at least MIN_RANGE
+ *
+ * @return bool Evidence that the sizes were valid, nothing changes if not
+ *
+ * @note Base stations added later start with the defaults again
+ */
+bool Simulation::setMap( int mapSize, int range )
+{
+    int base;
+
+    if( mapSize < 1 || range < MIN_RANGE )
+    {
+        return false;
+    }
+
+    for( base = 0; base < (int)network.partitions.size(); base++ )
+    {
+        ::setMap( network.partitions[base], mapSize, range );
+    }
+
+    return true;
+}
+
+/**
+ * @brief Sets how often every base station consolidates its relays
+ *
+ * @param in: minutes
+ *            Minutes between consolidateRelays passes, 0 for never
+ *
+ * @return void
+ *
+ * @note Base stations added later start with the default again
+ */
+void Simulation::setConsolidation( int minutes )
+{
+    int base;
+
+    for( base = 0; base < (int)network.partitions.size(); base++ )
+    {
+        network.partitions[base].consolidateEvery = minutes;
+    }
+}
+
+/**
+ * @brief Sets the number of threads the Simulation may use
+ *
+ * @details Used both to advance base stations side by side and to split the
+ *          battery tick of a large Fleet
+ *
+ * @param in: workers
+ *            Maximum number of threads, at least 1
+ *
+ * @return void
+ *
+ * @note None
+ */
+void Simulation::setWorkers( int workers )
+{
+    int base;
+
+    network.workers = workers;
+    for( base = 0; base < (int)network.partitions.size(); base++ )
+    {
+        network.partitions[base].workers = workers;
+    }
+}
+
+/**
+ * @brief Turns the event lines printed to cout on or off
+ *
+ * @param in: console
+ *            True to print replacements and packet hops
+ *
+ * @return void
+ *
+ * @note None
+ */
+void Simulation::setConsole( bool console )
+{
+    int base;
+
+    for( base = 0; base < (int)network.partitions.size(); base++ )
+    {
+        network.partitions[base].console = console;
+    }
+}
+
+/**
+ * @brief Records the events of every base station to a telemetry log
+ *
+ * @param in: telemetry
+ *            Open log, NULL to stop recording
+ *
+ * @return void
+ *
+ * @note Set NULL before closing the log so every event reaches it
+ */
+void Simulation::setTelemetry( Telemetry* telemetry )
+{
+    int base;
+
+    for( base = 0; base < (int)network.partitions.size(); base++ )
+    {
+        network.partitions[base].telemetry = telemetry;
+    }
+}
+
+/**
+ * @brief Sets aside room so a run within the given numbers of Drones and
+ *        Disasters does not allocate
+ *
+ * @param in: drones
+ *            Most Drones any one base station will hold
+ *
+ *            disasters
+ *            Most Disasters that will be active at once
+ *
+ * @return void
+ *
+ * @note See networkReserve, call after the base stations are added
+ */
+void Simulation::reserve( int drones, int disasters )
+{
+    networkReserve( network, disasterSet, drones, disasters );
+}
+
+/**
+ * @brief Adds a Disaster at the given coordinates if a relay can reach it
+ *
+ * @param in: xPos
+ *            x coordinate of the Disaster
+ *
+ *            yPos
+ *            y coordinate of the Disaster
+ *
+ * @return bool Evidence of successfully established relay
+ *
+ * @note See addDisaster
+ */
+bool Simulation::addDisaster( int xPos, int yPos )
+{
+    return ::addDisaster( network, disasterSet, xPos, yPos );
+}
+
+/**
+ * @brief Resolves a Disaster, landing the Drones of its relay
+ *
+ * @param in: disNum
+ *            Number of the Disaster
+ *
+ * @return bool Evidence that an active Disaster was resolved
+ *
+ * @note See resolveDisaster
+ */
+bool Simulation::resolveDisaster( int disNum )
+{
+    return ::resolveDisaster( network, disasterSet, disNum );
+}
+
+/**
+ * @brief Puts a new, fully charged Drone into service at a base station
+ *
+ * @param in: base
+ *            Partition of the base station
+ *
+ * @return int index of the Drone in the base station's Fleet, -1 if there
+ *         is no such base station
+ *
+ * @note See addDrone
+ */
+int Simulation::addDrone( int base )
+{
+    if( base < 0 || base >= (int)network.partitions.size() )
+    {
+        return -1;
+    }
+
+    return ::addDrone( network.partitions[base] );
+}
+
+/**
+ * @brief Takes a Drone of a base station out of service
+ *
+ * @param in: base
+ *            Partition of the base station
+ *
+ *            index
+ *            Index of the Drone in the base station's Fleet
+ *
+ * @return bool Evidence that the Drone was taken out of service
+ *
+ * @note See loseDrone
+ */
+bool Simulation::loseDrone( int base, int index )
+{
+    return base >= 0 && base < (int)network.partitions.size()
+           && ::loseDrone( index, network.partitions[base], -1 );
+}
+
+/**
+ * @brief Simulates the given number of minutes on every base station
+ *
+ * @param in: minutes
+ *            Number of minutes to simulate
+ *
+ * @return void
+ *
+ * @note See networkAdvance
+ */
+void Simulation::advance( int minutes )
+{
+    networkAdvance( network, minutes );
+}
+
+/**
+ * @brief Sends a packet from the given coordinates to whichever base
+ *        station's relays it enters
+ *
+ * @param in: xPos
+ *            x coordinate the packet is sent from
+ *
+ *            yPos
+ *            y coordinate the packet is sent from
+ *
+ * @return bool Evidence of successful packet send
+ *
+ * @note See networkRoute and sendPacketFrom
+ */
+bool Simulation::sendPacket( int xPos, int yPos )
+{
+    int base = networkRoute( network, xPos, yPos );
+
+    return base >= 0 && sendPacketFrom( network.partitions[base], xPos, yPos );
+}
+
+/**
+ * @brief Sends a batch of packets through whichever base stations they
+ *        enter
+ *
+ * @param in: xPos
+ *            x coordinates the packets are sent from
+ *
+ *            yPos
+ *            y coordinates the packets are sent from
+ *
+ *            count
+ *            Number of packets
+ *
+ *            batch
+ *            Scratch space, and counters the results are added to
+ *
+ * @return void
+ *
+ * @note See networkSendBatch
+ */
+void Simulation::sendPackets( const int* xPos, const int* yPos, int count,
+                              PacketBatch& batch )
+{
+    networkSendBatch( network, xPos, yPos, count, batch );
+}
+
+/**
+ * @brief Sends packets from every active Disaster through the relays a hop
+ *        at a time while the clock runs
+ *
+ * @param in: perMinute
+ *            Packets sent each minute
+ *
+ *            minutes
+ *            Number of minutes to run
+ *
+ *            pipelines
+ *            One pipeline per base station, and the results
+ *
+ * @return bool Evidence that there was a Disaster to send from, or no
+ *         packet to send
+ *
+ * @note See networkTraffic
+ */
+bool Simulation::runTraffic( int perMinute, int minutes,
+                             vector<PacketPipeline>& pipelines )
+{
+    return networkTraffic( network, disasterSet, perMinute, minutes,
+                           pipelines );
+}
+
+/**
+ * @brief Runs the commands of a scenario stream against the Simulation
+ *
+ * @param in: in
+ *            Stream of scenario commands
+ *
+ * @return bool True if every command was valid
+ *
+ * @note See runScenario
+ */
+bool Simulation::runScenario( istream& in )
+{
+    return ::runScenario( in, network, disasterSet );
+}
+
+/**
+ * @brief Writes the state of the Simulation to a snapshot file
+ *
+ * @param in: path
+ *            File to write
+ *
+ * @return bool Evidence that the snapshot was written
+ *
+ * @note A snapshot holds a single Fleet, so only a Simulation with one base
+ *       station can be saved
+ */
+bool Simulation::save( const char* path ) const
+{
+    return network.partitions.size() == 1
+           && saveSnapshot( path, network.partitions[0], disasterSet );
+}
+
+/**
+ * @brief Replaces the state of the Simulation with a snapshot file
+ *
+ * @details The snapshot becomes the only base station. Threads, console
+ *          and telemetry are run settings rather than state, so they carry
+ *          over from the first base station if there was one. A bad file
+ *          leaves the Simulation as it was
+ *
+ * @param in: path
+ *            File to read
+ *
+ * @return bool Evidence that the snapshot was valid and loaded
+ *
+ * @note None
+ */
+bool Simulation::restore( const char* path )
+{
+    Fleet restored;
+    vector<Disaster> disasters;
+
+    if( !loadSnapshot( path, restored, disasters ) )
+    {
+        return false;
+    }
+
+    if( !network.partitions.empty() )
+    {
+        restored.workers = network.partitions[0].workers;
+        restored.console = network.partitions[0].console;
+        restored.telemetry = network.partitions[0].telemetry;
+    }
+
+    network.partitions.clear();
+    network.partitions.push_back( restored );
+    disasterSet.swap( disasters );
+    networkFreeDisasters( network, disasterSet );
+
+    return true;
+}
+
+/**
+ * @brief Prints the relay of every Disaster to cout
+ *
+ * @param in: None
+ *
+ * @return void
+ *
+ * @note See displayRelay
+ */
+void Simulation::displayRelay() const
+{
+    ::displayRelay( network, disasterSet );
+}
+
+/**
+ * @brief Prints the map of base stations, Drones and Disasters to cout
+ *
+ * @param in: None
+ *
+ * @return void
+ *
+ * @note See printMap, the frame is kept for the next call
+ */
+void Simulation::printMap()
+{
+    ::printMap( network, disasterSet, frame );
+}
+
+/**
+ * @brief Prints the clock, Drones in flight and relays to cout
+ *
+ * @param in: None
+ *
+ * @return void
+ *
+ * @note See dumpState
+ */
+void Simulation::dumpState() const
+{
+    ::dumpState( network, disasterSet );
+}
+
+/**
+ * @brief Prints the occupancy of the Drone and Disaster pools to cout
+ *
+ * @param in: None
+ *
+ * @return void
+ *
+ * @note See dumpPools
+ */
+void Simulation::dumpPools() const
+{
+    ::dumpPools( network );
+}
+
+/**
+ * @brief Gives access to the base stations and their Fleets
+ *
+ * @param in: None
+ *
+ * @return BaseNetwork& network of the Simulation
+ *
+ * @note None
+ */
+BaseNetwork& Simulation::getNetwork()
+{
+    return network;
+}
+
+/**
+ * @brief Gives read access to the base stations and their Fleets
+ *
+ * @param in: None
+ *
+ * @return const BaseNetwork& network of the Simulation
+ *
+ * @note None
+ */
+const BaseNetwork& Simulation::getNetwork() const
+{
+    return network;
+}
+
+/**
+ * @brief Gives read access to the Disasters with an established relay
+ *
+ * @param in: None
+ *
+ * @return const vector<Disaster>& Disasters by number, resolved ones with
+ *         disNum -1
+ *
+ * @note None
+ */
+const vector<Disaster>& Simulation::getDisasters() const
+{
+    return disasterSet;
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
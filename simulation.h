@@ -0,0 +1,82 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file simulation.h
+ *
+ * @details Header file for the Simulation engine object, the public header
+ *          of libsim.a. A program that embeds the simulator includes this
+ *          file and links the library
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Class Definitions //////////////////////////////////////////////////////////
+
+/**
+ * @brief Simulation class owns everything one run of the simulator needs
+ *
+ * @details The base stations with their Fleets, relays and random number
+ *          generators live in the BaseNetwork, and the Disasters beside it.
+ *          Nothing is kept in globals, so any number of Simulations can run
+ *          side by side, one per thread. Code that works on a single Fleet
+ *          includes simulator.h and the module headers it calls instead
+ */
+class Simulation
+{
+    public:
+        Simulation();
+
+        void addBase( int xPos, int yPos, int drones, int reserve,
+                      uint64_t seed );
+        bool setMap( int mapSize, int range );
+        void setConsolidation( int minutes );
+        void setWorkers( int workers );
+        void setConsole( bool console );
+        void setTelemetry( Telemetry* telemetry );
+        void reserve( int drones, int disasters );
+
+        bool addDisaster( int xPos, int yPos );
+        bool resolveDisaster( int disNum );
+        int addDrone( int base );
+        bool loseDrone( int base, int index );
+        void advance( int minutes );
+        bool sendPacket( int xPos, int yPos );
+        void sendPackets( const int* xPos, const int* yPos, int count,
+                          PacketBatch& batch );
+        bool runTraffic( int perMinute, int minutes,
+                         vector<PacketPipeline>& pipelines );
+        bool runScenario( istream& in );
+        bool save( const char* path ) const;
+        bool restore( const char* path );
+
+        void displayRelay() const;
+        void printMap();
+        void dumpState() const;
+        void dumpPools() const;
+
+        BaseNetwork& getNetwork();
+        const BaseNetwork& getNetwork() const;
+        const vector<Disaster>& getDisasters() const;
+
+    private:
+        BaseNetwork network;
+        vector<Disaster> disasterSet;
+        MapFrame frame; //reused by printMap
+};
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -20,51 +20,343 @@
 #include <cstdlib>
 #include <vector>
 #include "simulator.h"
+#include "parallel.h"
+#include "rng.h"
+#include "pool.h"
+#include "instrument.h"
+#include "kernels.h"
+#include "idlequeue.h"
+#include "spatialgrid.h"
+#include "pipeline.h"
+#include "maprender.h"
+#include "relays.h"
+#include "planner.h"
+#include "repair.h"
+#include "consolidate.h"
+#include "teardown.h"
+#include "bases.h"
+#include "telemetry.h"
 
 using namespace std;
 
 // Begin Function Definitions /////////////////////////////////////////////////
 
 /**
- * @brief Creates an array of Drones and initializes all Drones with default
+ * @brief Sizes the Fleet arrays and initializes all Drones with default
  *        values for all data fields
  *
- * @details Each Drone is given an ID, a random starting battery level 
- *          between 50-100 (100 is a full battery, 0 is an empty battery),
- *          and default values for the rest of the fields
+ * @details Each Drone is identified by its index, given a random starting
+ *          battery level between 50-100 (100 is a full battery, 0 is an
+ *          empty battery), and default values for the rest of the fields.
+ *          Every Drone starts in the idle queue at the base station, which
+ *          keeps DEFAULT_RESERVE percent of the Fleet for replacements and
+ *          replaces Drones below DEFAULT_LOW_BATTERY. The map and range
+ *          start at their defaults, see setMap
  *          
  * @param in: fleet
- *            An empty array of Drones passed by reference to be filled with data
+ *            An empty Fleet passed by reference to be filled with data
+ *
+ *            fleetSize
+ *            Number of Drones in the Fleet
+ *
+ *            seed
+ *            Seed of the Fleet's random number generator, the same seed
+ *            gives the same Fleet
+ *
+ *            baseX
+ *            x coordinate of the Fleet's Command and Control Center
+ *
+ *            baseY
+ *            y coordinate of the Fleet's Command and Control Center
  *
  * @return void
  *
  * @note None
  */
-void generateFleet( Drone*& fleet )
+void generateFleet( Fleet& fleet, const int fleetSize, const uint64_t seed,
+                    const int baseX, const int baseY )
 {
     int index;
     
-    fleet = new Drone[FLEET_SIZE];
+    fleet.size = fleetSize;
+    fleet.battery.resize( fleetSize );
+    fleet.xPos.assign( fleetSize, baseX );
+    fleet.yPos.assign( fleetSize, baseY );
+    fleet.disNum.assign( fleetSize, -1 );
+    fleet.inFlight.assign( fleetSize, false );
+    fleet.firstDrone.assign( fleetSize, false );
+    fleet.previous.assign( fleetSize, -1 );
+    fleet.next.assign( fleetSize, -1 );
+    fleet.clock = 0;
+    fleet.mapSize = DEFAULT_MAP_SIZE;
+    fleet.range = DEFAULT_RANGE;
+    fleet.baseX = baseX;
+    fleet.baseY = baseY;
+    fleet.reserve = DEFAULT_RESERVE;
+    fleet.lowBattery = DEFAULT_LOW_BATTERY;
+    fleet.consolidateEvery = DEFAULT_CONSOLIDATE_EVERY;
+    fleet.dronesUsed = 0;
+    fleet.replacements = 0;
+    fleet.replaceFailures = 0;
+    fleet.repairs = 0;
+    fleet.consolidated = 0;
+    fleet.workers = defaultWorkers();
+    fleet.relays.clear();
+    fleet.shared.clear();
+    fleet.console = true;
+    fleet.telemetry = NULL;
+    fleet.pipeline = NULL;
+    poolReset( fleet.drones, fleetSize );
+    rngSeed( fleet.rng, seed );
+    
+    for( index = 0; index < fleetSize; index++ )
+    {
+        fleet.battery[index] = rngRange( fleet.rng, 50, 100 ); //battery at random value 50-100
+    }
+    
+    idleBuild( fleet );
+    gridBuild( fleet );
+}
+
+/**
+ * @brief Grows every array indexed by Drone to a number of slots
+ *
+ * @details New slots hold a Drone at the base station that is in neither
+ *          the idle queue nor the grid
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            slots
+ *            New number of slots, at least fleet.size
+ *
+ * @return void
+ *
+ * @note Does not allocate within the capacity set by reserveFleet
+ */
+static void growFleet( Fleet& fleet, int slots )
+{
+    fleet.size = slots;
+    fleet.battery.resize( slots, 0 );
+    fleet.xPos.resize( slots, fleet.baseX );
+    fleet.yPos.resize( slots, fleet.baseY );
+    fleet.disNum.resize( slots, -1 );
+    fleet.inFlight.resize( slots, false );
+    fleet.firstDrone.resize( slots, false );
+    fleet.previous.resize( slots, -1 );
+    fleet.next.resize( slots, -1 );
+    fleet.idle.chargeKey.resize( slots, 0 );
+    fleet.idle.charging.position.resize( slots, -1 );
+    fleet.idle.charged.position.resize( slots, -1 );
+    fleet.airborne.cellOf.resize( slots, -1 );
+    fleet.airborne.slot.resize( slots, -1 );
+}
+
+/**
+ * @brief Sets aside room for a number of Drones and Disasters so a run
+ *        that stays within them never allocates
+ *
+ * @details Reserves the Drone arrays and drones pool, the idle queue and
+ *          grid maps, the relay registry and every scratch buffer. Only
+ *          capacity changes, so it can be called at any time. The cells of
+ *          the grid still grow the first time Drones crowd into them
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            drones
+ *            Most Drones the Fleet will hold, lost ones included
+ *
+ *            disasters
+ *            Most Disasters that will be active at once
+ *
+ * @return void
+ *
+ * @note O(drones + disasters)
+ */
+void reserveFleet( Fleet& fleet, int drones, int disasters )
+{
+    int part;
+    int parts = partitionCount( drones, fleet.workers );
+
+    fleet.battery.reserve( drones );
+    fleet.xPos.reserve( drones );
+    fleet.yPos.reserve( drones );
+    fleet.disNum.reserve( drones );
+    fleet.inFlight.reserve( drones );
+    fleet.firstDrone.reserve( drones );
+    fleet.previous.reserve( drones );
+    fleet.next.reserve( drones );
+    fleet.idle.chargeKey.reserve( drones );
+    fleet.idle.charging.nodes.reserve( drones );
+    fleet.idle.charging.position.reserve( drones );
+    fleet.idle.charged.nodes.reserve( drones );
+    fleet.idle.charged.position.reserve( drones );
+    fleet.airborne.cellOf.reserve( drones );
+    fleet.airborne.slot.reserve( drones );
+    poolReserve( fleet.drones, drones );
+    fleet.relays.reserve( disasters );
+    fleet.shared.reserve( disasters );
+    fleet.scratch.nearby.reserve( drones );
+    fleet.scratch.children.reserve( drones );
+    fleet.scratch.parents.reserve( drones );
+    fleet.scratch.members.reserve( drones );
+    fleet.scratch.flightKey.reserve( drones );
+    fleet.scratch.due.reserve( drones );
+    fleet.scratch.events.reserve( 2 * drones );
+    fleet.scratch.plan.xPos.reserve( drones );
+    fleet.scratch.plan.yPos.reserve( drones );
+    fleet.scratch.plan.found.reserve( drones );
+    
+    if( (int)fleet.scratch.lowBattery.size() < parts )
+    {
+        fleet.scratch.lowBattery.resize( parts );
+    }
+    for( part = 0; part < (int)fleet.scratch.lowBattery.size(); part++ )
+    {
+        fleet.scratch.lowBattery[part].reserve( drones );
+    }
+}
+
+/**
+ * @brief Puts a new, fully charged Drone into service at the base station
+ *
+ * @details The Drone takes the slot of a lost Drone if there is one, most
+ *          recently lost first, otherwise the arrays grow by one slot. It
+ *          joins the idle queue like a Drone that just landed
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ * @return int index of the new Drone
+ *
+ * @note O(log n) amortized, see reserveFleet
+ */
+int addDrone( Fleet& fleet )
+{
+    int index = poolAcquire( fleet.drones );
     
-    for( index = 0; index < FLEET_SIZE; index++ )
+    if( index >= fleet.size )
+    {
+        growFleet( fleet, index + 1 );
+    }
+    
+    fleet.battery[index] = 100;
+    fleet.xPos[index] = fleet.baseX;
+    fleet.yPos[index] = fleet.baseY;
+    fleet.disNum[index] = -1;
+    fleet.inFlight[index] = false;
+    fleet.firstDrone[index] = false;
+    fleet.previous[index] = -1;
+    fleet.next[index] = -1;
+    idleInsert( fleet, index );
+    logEvent( fleet, EVENT_DRONE_ADDED, index, -1, fleet.baseX, fleet.baseY );
+    
+    if( fleet.console )
+    {
+        cout << "Drone #" << index << " added to fleet" << '\n';
+    }
+    
+    return index;
+}
+
+/**
+ * @brief Takes a Drone out of service
+ *
+ * @details An in flight Drone is first replaced, or its relay repaired
+ *          around it, the same way as when its battery runs low. The Drone
+ *          then leaves the idle queue and its slot goes back to the drones
+ *          pool for addDrone to reuse
+ *
+ * @param in: index
+ *            Index of the Drone
+ *
+ *            fleet
+ *            Fleet of all Drones, batteries current
+ *
+ *            currentTime
+ *            Needed for reference when printing Drone information
+ *
+ * @return bool Evidence that the Drone was in service and taken out, false
+ *         if it is in flight and its relay cannot do without it
+ *
+ * @note O(replaceDrone + repairRelay)
+ */
+bool loseDrone( const int index, Fleet& fleet, const int currentTime )
+{
+    if( !poolLive( fleet.drones, index ) )
+    {
+        return false;
+    }
+    
+    if( fleet.inFlight[index] && !replaceDrone( index, fleet, currentTime )
+         && !repairRelay( index, fleet, currentTime ) )
+    {
+        return false;
+    }
+    
+    idleRemove( fleet, index );
+    poolRelease( fleet.drones, index );
+    fleet.battery[index] = 0;
+    logEvent( fleet, EVENT_DRONE_LOST, index, -1, fleet.baseX, fleet.baseY );
+    
+    if( fleet.console )
+    {
+        cout << "Drone #" << index << " lost";
+        
+        if( currentTime >= 0 )
+        {
+            cout << " at time " << currentTime;
+        }
+        
+        cout << '\n';
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Sets the size of the map a Fleet flies over and the range of its
+ *        Drones
+ *
+ * @details Both are in map units, so a 100km map with 1km links and 1m
+ *          units is setMap( fleet, 100000, 1000 ). The spatial grid is
+ *          rebuilt for the new sizes. A range below MIN_RANGE is refused,
+ *          since a link of 1 cannot step diagonally and planRelay could not
+ *          reach most of the map
+ *          
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            mapSize
+ *            Map spans 0-mapSize on both axes
+ *
+ *            range
+ *            Longest link between two Drones
+ *
+ * @return bool Evidence that the sizes were valid and set
+ *
+ * @note The base station and every Drone should already be on the new map
+ */
+bool setMap( Fleet& fleet, const int mapSize, const int range )
+{
+    if( mapSize < 1 || range < MIN_RANGE )
     {
-        fleet[index].droneID = index;
-        fleet[index].battery = (50 + rand() % 51); //battery at random value 50-100
-        fleet[index].xPos = 0;
-        fleet[index].yPos = 0;
-        fleet[index].disNum = -1;
-        fleet[index].previous = NULL;
-        fleet[index].next = NULL;
-        fleet[index].inFlight = false;
-        fleet[index].firstDrone = false;
+        return false;
     }
+
+    fleet.mapSize = mapSize;
+    fleet.range = range;
+    gridBuild( fleet );
+
+    return true;
 }
 
 /**
  * @brief Takes input from the console of the coordinates of a new disaster
  *
- * @details Disaster coordinates must be between 1-100 for x and y. Coordinates
- *          are saved into the Disaster struct
+ * @details Disaster coordinates must be between 1-mapSize for x and y.
+ *          Coordinates are saved into the Disaster struct
  *          
  * @param in: dis
  *            A Disaster struct passed by reference for the coordinates to be
@@ -73,167 +365,298 @@ void generateFleet( Drone*& fleet )
  *            disCount
  *            Used by main function to keep track of how many Disasters exist
  *
+ *            mapSize
+ *            Largest coordinate on the map
+ *
  * @return void
  *
  * @note None
  */
-void makeDisaster( Disaster& dis, const int disCount )
+void makeDisaster( Disaster& dis, const int disCount, const int mapSize )
 {
-    cout << "Enter x coordinate of disaster (1-100): ";
+    cout << "Enter x coordinate of disaster (1-" << mapSize << "): ";
     cin >> dis.xPos;
-    while( dis.xPos > 100 || dis.xPos < 1 )
+    while( dis.xPos > mapSize || dis.xPos < 1 )
     {
-        cout << "Must be between 1 and 100: ";
+        cout << "Must be between 1 and " << mapSize << ": ";
         cin >> dis.xPos;
     }
-    cout << "Enter y coordinate of disaster (1-100): ";
+    cout << "Enter y coordinate of disaster (1-" << mapSize << "): ";
     cin >> dis.yPos;
-    while( dis.yPos > 100 || dis.yPos < 1 )
+    while( dis.yPos > mapSize || dis.yPos < 1 )
     {
-        cout << "Must be between 1 and 100: ";
+        cout << "Must be between 1 and " << mapSize << ": ";
         cin >> dis.yPos;
     }
     
     dis.disNum = disCount;
 }
 
+/**
+ * @brief Adds a Disaster at the given coordinates if a relay can reach it
+ *
+ * @details The Disaster takes the next number from the network's disasters
+ *          pool, the number of the most recently resolved Disaster if there
+ *          is one, otherwise the one after the Disasters already in the set,
+ *          and is passed to generateRelay on the partition networkCheapest
+ *          picks. The number is only taken, and the Disaster added to the
+ *          set, when the relay is established. The result is printed when
+ *          the console of that partition is on
+ *          
+ * @param in: network
+ *            Fleets of all base stations
+ *
+ *            disasterSet
+ *            Vector containing all disaster data
+ *
+ *            xPos
+ *            x coordinate of the Disaster
+ *
+ *            yPos
+ *            y coordinate of the Disaster
+ *
+ * @return bool Evidence of successfully established relay
+ *
+ * @note None
+ */
+bool addDisaster( BaseNetwork& network, vector<Disaster>& disasterSet,
+                  int xPos, int yPos )
+{
+    Disaster dis;
+    bool console = false;
+    int base;
+    
+    dis.xPos = xPos;
+    dis.yPos = yPos;
+    dis.disNum = poolPeek( network.disasters );
+    dis.base = networkCheapest( network, xPos, yPos );
+
+    //a Disaster no partition can serve is reported on any console that is on
+    for( base = 0; base < (int)network.partitions.size(); base++ )
+    {
+        console = console || network.partitions[base].console;
+    }
+    if( dis.base >= 0 )
+    {
+        console = network.partitions[dis.base].console;
+    }
+    
+    if( dis.base >= 0 && generateRelay( dis, network.partitions[dis.base] ) )
+    {
+        poolAcquire( network.disasters );
+        if( dis.disNum < (int)disasterSet.size() )
+        {
+            disasterSet[dis.disNum] = dis;
+        }
+        else
+        {
+            disasterSet.push_back( dis );
+        }
+
+        if( console )
+        {
+            cout << '\n' << "Relay network successfully established" << '\n';
+        }
+        return true;
+    }
+    
+    if( console )
+    {
+        cout << '\n' 
+             << "Failed to generate relay network: not enough drones available"
+             << '\n' << '\n';
+    }
+    return false;
+}
+
+/**
+ * @brief Resolves a Disaster, landing the Drones of its relay
+ *
+ * @details The relay is torn down on the partition serving the Disaster,
+ *          see teardownRelay. Its slot in the set stays with disNum -1 and
+ *          its number goes back to the network's disasters pool, so the next
+ *          Disaster reuses both and a long run never holds more Disasters
+ *          than were active at once. The result is printed when the
+ *          partition's console is on
+ *          
+ * @param in: network
+ *            Fleets of all base stations
+ *
+ *            disasterSet
+ *            Vector containing all disaster data
+ *
+ *            disNum
+ *            Number of the Disaster
+ *
+ * @return bool Evidence that an active Disaster was resolved
+ *
+ * @note O(teardownRelay)
+ */
+bool resolveDisaster( BaseNetwork& network, vector<Disaster>& disasterSet,
+                      int disNum )
+{
+    int landed;
+    
+    if( disNum < 0 || disNum >= (int)disasterSet.size()
+         || disasterSet[disNum].disNum < 0 )
+    {
+        return false;
+    }
+    
+    Fleet& fleet = network.partitions[disasterSet[disNum].base];
+    
+    landed = teardownRelay( fleet, disNum );
+    disasterSet[disNum].disNum = -1;
+    poolRelease( network.disasters, disNum );
+    logEvent( fleet, EVENT_DISASTER_RESOLVED, -1, disNum,
+              disasterSet[disNum].xPos, disasterSet[disNum].yPos );
+    
+    if( fleet.console )
+    {
+        cout << '\n' << "Disaster #" << disNum << " resolved, " << landed
+             << ( landed == 1 ? " drone" : " drones" ) << " returned to base"
+             << '\n';
+    }
+    
+    return true;
+}
+
 /**
  * @brief If possible assigns availible drones to a Disaster to establish a
  *        link to the Command and Control Center
  *
- * @details Uses calculated distances and Drone information to determine if
- *          a relay is possible. If it is Drones are assigned to the relay
- *          and marked in flight
+ * @details A Disaster already within reach of an in flight Drone needs no
+ *          relay. Otherwise planRelay picks where the relay attaches to the
+ *          network and how few Drones can bridge the gap, and the highest
+ *          battery idle Drones are flown to the planned positions and marked
+ *          in flight
  *          
  * @param in: dis
  *            Disaster in need of a Drone relay
  *
  *            fleet
- *            Drone Array of all Drones
+ *            Fleet of all Drones
  *
  * @return bool Evidence of successfully established relay 
  *
  * @note Only establishes a relay if possible to establish relay and maintain
- *       20% of total Drone count in Command and Control Center
+ *       the Fleet's reserve at its Command and Control Center
  */
-bool generateRelay( const Disaster& dis, Drone*& fleet )
+bool generateRelay( const Disaster& dis, Fleet& fleet )
 {
-    int nextIndex, last;
-    int prevX = 0, prevY = 0;
+    INSTRUMENT_SCOPE( PROBE_GENERATE_RELAY );
+    RelayPlan& plan = fleet.scratch.plan;
+    int nextIndex, step;
     int closestDrone = findClosest( fleet, dis );
-    int distanceToDisaster;
-    int numDronesNeeded;
-    Drone* prevDrone = NULL;
+    int prevDrone;
     nextIndex = highestPower( fleet );
+    relayReset( fleet, dis.disNum );
     
     if( nextIndex < 0 )
     {
         return false;
     }
     
-    if( closestDrone < 0 )
-    {
-        distanceToDisaster = distance( 0, 0, dis.xPos, dis.yPos );
-        prevX = 0;
-        prevY = 0;
-    }
-    else
-    {
-        distanceToDisaster = distance( fleet[closestDrone].xPos,
-                    fleet[closestDrone].yPos, dis.xPos, dis.yPos );
-        prevX = fleet[closestDrone].xPos;
-        prevY = fleet[closestDrone].yPos;
-        prevDrone = &(fleet[closestDrone]);
-    }
-    
-    if( distanceToDisaster < MAX_CONNECTION_DIST - MAX_CONNECTION_DIST * .05 
-        && closestDrone >= 0 )
+    if( closestDrone >= 0 && inReach( fleet, fleet.xPos[closestDrone],
+                            fleet.yPos[closestDrone], dis.xPos, dis.yPos ) )
     {
+        fleet.relays[dis.disNum].xPos = dis.xPos;
+        fleet.relays[dis.disNum].yPos = dis.yPos;
+        relayShare( fleet, dis.disNum );
         return true;
     }
     
-    numDronesNeeded = max( 1, (int)ceil( (float)distanceToDisaster
-                                    / (float)MAX_CONNECTION_DIST ) );
-    
-    //keep 20% of total drones available to replace drones as they time out
-    if( numDronesNeeded > FLEET_SIZE * 0.8 - dronesUsed )
+    if( !planRelay( fleet, dis.xPos, dis.yPos, plan )
+         || !withinReserve( fleet, plan.xPos.size() ) )
     {
         return false;
     }
     
-    do
+    prevDrone = plan.attach;
+    for( step = 0; step < (int)plan.xPos.size(); step++ )
     {
+        nextIndex = highestPower( fleet );
         if( nextIndex < 0 )
         {
             return false;
         }
         
-        fleet[nextIndex].inFlight = true;
-        dronesUsed++;
-        fleet[nextIndex].disNum = dis.disNum;
-        
-        //calculate drone coordinates with 5% margin of error
-        prevX = ceil( (float)(dis.xPos-prevX) / (float)max(numDronesNeeded, 1) )
-                            + prevX - MAX_CONNECTION_DIST
-                            * .05 * getDirVector( prevX, prevY, dis.xPos, dis.yPos);
-        fleet[nextIndex].xPos = prevX;
-        prevY = ceil( (float)(dis.yPos-prevY) / (float)max(numDronesNeeded, 1) )
-                            + prevY - MAX_CONNECTION_DIST
-                            * .05 * getDirVector( prevX, prevY, dis.yPos, dis.xPos);
-        fleet[nextIndex].yPos = prevY;
-        //cout << prevY << endl << prevX << endl;
-        fleet[nextIndex].previous = prevDrone;
-        if( prevDrone != NULL && prevDrone->disNum == dis.disNum )
+        idleRemove( fleet, nextIndex );
+        fleet.inFlight[nextIndex] = true;
+        fleet.dronesUsed++;
+        fleet.disNum[nextIndex] = dis.disNum;
+        fleet.xPos[nextIndex] = plan.xPos[step];
+        fleet.yPos[nextIndex] = plan.yPos[step];
+        gridInsert( fleet, nextIndex );
+        relayAppend( fleet, dis.disNum, nextIndex );
+        logEvent( fleet, EVENT_DISPATCHED, nextIndex, dis.disNum,
+                  plan.xPos[step], plan.yPos[step] );
+        INSTRUMENT_SCANNED( PROBE_GENERATE_RELAY, 1 );
+        fleet.previous[nextIndex] = prevDrone;
+        if( step > 0 )
         {
-            prevDrone->next = &(fleet[nextIndex]);
+            fleet.next[prevDrone] = nextIndex;
         }
         else
         {
-            fleet[nextIndex].firstDrone = true;
+            fleet.firstDrone[nextIndex] = true;
         }
-        prevDrone = &(fleet[nextIndex]);
-        last = fleet[nextIndex].droneID;
-        nextIndex = highestPower( fleet );
-        numDronesNeeded--;
-    } while( distance( fleet[last].xPos, fleet[last].yPos, dis.xPos, dis.yPos )
-                > MAX_CONNECTION_DIST );
+        prevDrone = nextIndex;
+    }
 
+    fleet.relays[dis.disNum].xPos = dis.xPos;
+    fleet.relays[dis.disNum].yPos = dis.yPos;
     return true;
 }
 
 /**
- * @brief Returns the index of the Drone with the most full battery
+ * @brief Decides whether a Fleet can send out more Drones and keep its
+ *        reserve
  *
- * @details Loops through every Drone and finds the maximum battery value
+ * @details The reserve is the percent of the Drones in service kept at the
+ *          base station to replace Drones as they time out
  *          
  * @param in: fleet
- *            Drone array of all desired Drones to search through
+ *            Fleet of all Drones
+ *
+ *            drones
+ *            Number of Drones to send out
  *        
- * @return int index of highest battery Drone
+ * @return bool True if the Drones can be sent
  *
  * @note None
  */
-int highestPower( const Drone* fleet )
+bool withinReserve( const Fleet& fleet, int drones )
 {
-    int max = -1;
-    int highestPower = 0;
-    int index;
-    for( index = 0; index < FLEET_SIZE; index++ )
-    {
-        if( fleet[index].battery > highestPower && !fleet[index].inFlight )
-        {
-            highestPower = fleet[index].battery;
-            max = index;
-        }
-    }
-    
-    return max;
+    return (long)( fleet.dronesUsed + drones ) * 100
+                    <= (long)fleet.drones.used * ( 100 - fleet.reserve );
+}
+
+/**
+ * @brief Returns the index of the Drone with the most full battery
+ *
+ * @details Reads the top of the idle queue instead of scanning the fleet.
+ *          Ties go to the lowest index, and a Drone with no charge is never
+ *          returned
+ *          
+ * @param in: fleet
+ *            Fleet of all desired Drones to search through
+ *        
+ * @return int index of highest battery Drone, -1 if none is available
+ *
+ * @note O(log n) amortized, see idleBest
+ */
+int highestPower( Fleet& fleet )
+{
+    return idleBest( fleet );
 }
 
 /**
- * @brief Calculates the distance between two points on an xy plane
+ * @brief Calculates the squared distance between two points on an xy plane
  *
- * @details Uses the distance formula
+ * @details Uses the distance formula without the square root, in 64 bits
+ *          so any two points on the map work. Compare against a squared
+ *          limit instead of taking a root
  *          
  * @param in: x1
  *            First x coordinate
@@ -247,87 +670,63 @@ int highestPower( const Drone* fleet )
  *            y2
  *            Second y coordinate
  *
- * @return int result of distance calculation
+ * @return long long result of distance calculation, squared
  *
  * @note None
  */
-int distance( int x1, int y1, int x2, int y2 )
+long long distSquared( int x1, int y1, int x2, int y2 )
 {
-    int x = x2-x1;
-    int y = y2-y1;
+    long long x = (long long)x2 - x1;
+    long long y = (long long)y2 - y1;
 
-    return sqrt( x*x + y*y );
+    return x*x + y*y;
 }
 
 /**
- * @brief Prints to console all relays to Disasters
+ * @brief Decides whether a point can reach a Drone at another point
  *
- * @details For every Disaster prints the relay information including DroneIDs,
- *          positions, and battery life 
+ * @details Packets enter a relay from within REACH_MARGIN of the Fleet's
+ *          range, and a Disaster that close to an in flight Drone needs no
+ *          relay of its own
  *          
  * @param in: fleet
- *            Drone array of all Drones
+ *            Fleet the Drone belongs to
  *
- *            disCount
- *            Number of Disasters
- *        
- * @return void
+ *            x1
+ *            First x coordinate
+ *
+ *            y1
+ *            First y coordinate
+ *
+ *            x2
+ *            Second x coordinate
+ *
+ *            y2
+ *            Second y coordinate
+ *
+ * @return bool True if the points are within reach
  *
  * @note None
  */
-void displayRelay( Drone* fleet, int disCount )
+bool inReach( const Fleet& fleet, int x1, int y1, int x2, int y2 )
 {
-    int droneIndex;
-    int disIndex;
-    bool relayExists = false;
-    bool lastNode = false;
-    Drone* current;
-    
-    cout << endl;
-    
-    for( disIndex = 0; disIndex < disCount; disIndex++ )
-    {
-        //find first drone in relay
-        for( droneIndex = 0; droneIndex < FLEET_SIZE; droneIndex++ )
-        {
-            if( fleet[droneIndex].firstDrone && fleet[droneIndex].disNum == disIndex )
-            {
-                relayExists = true;
-                break;
-            }
-        }
-        
-        cout << "Disaster #" << disIndex << ":" << endl;
-        
-        if(relayExists)
-        {
-            current = &(fleet[droneIndex]);
-            
-            while( current != NULL )
-            {
-                cout << "Drone #" << current->droneID << " is at " << current->xPos << ", "
-                     << current->yPos << ", battery = " << current->battery
-                     << "%" << endl;
-                
-                current = current->next;
-            }
-        }
-        else
-        {
-            cout << "Covered by other disaster relay" << endl;
-        }
-        
-        relayExists = false;
-    }
+    double reach = fleet.range * REACH_MARGIN;
 
+    return distSquared( x1, y1, x2, y2 ) <= reach * reach;
 }
 
 /**
- * @brief Calculates the direction vector for use in generateRelay
+ * @brief Decides whether two Drones, or a Drone and its base station, are
+ *        close enough to link
  *
- * @details Needed to determine the Drone relay path
+ * @details Links span the Fleet's full range, as planRelay spaces them.
+ *          Only packets entering a relay are held to REACH_MARGIN, see
+ *          inReach
  *          
- * @param in: x1
+ * @param in: fleet
+ *            Fleet the Drones belong to
+ *
+ *            x1
  *            First x coordinate
  *
  *            y1
@@ -337,34 +736,91 @@ void displayRelay( Drone* fleet, int disCount )
  *            Second x coordinate
  *
  *            y2
- *            Second y coordinate          
- *        
- * @return float 
+ *            Second y coordinate
+ *
+ * @return bool True if the points can be linked
  *
  * @note None
  */
-float getDirVector( int x1, int y1, int x2, int y2 )
+bool inRange( const Fleet& fleet, int x1, int y1, int x2, int y2 )
+{
+    return distSquared( x1, y1, x2, y2 )
+           <= (long long)fleet.range * fleet.range;
+}
+
+/**
+ * @brief Prints to console all relays to Disasters
+ *
+ * @details For every active Disaster prints the relay information
+ *          including DroneIDs, positions, and battery life. Each relay is
+ *          walked from the head kept in the relay registry of the partition
+ *          serving the Disaster, which is named when there is more than one
+ *          base station
+ *          
+ * @param in: network
+ *            Fleets of all base stations
+ *
+ *            disasterSet
+ *            Vector containing all disaster data
+ *        
+ * @return void
+ *
+ * @note O(disasters + relay Drones)
+ */
+void displayRelay( const BaseNetwork& network,
+                   const vector<Disaster>& disasterSet )
 {
-    float x = x2 - x1;
-    float y = y2 - y1;
+    int disIndex;
+    int current;
     
-    if( max(x, y) == 0 )
-    {
-        return 1;
-    }
-    else
+    cout << '\n';
+    
+    for( disIndex = 0; disIndex < (int)disasterSet.size(); disIndex++ )
     {
-        return min(x, y) / max(x, y);
+        if( disasterSet[disIndex].disNum < 0 )
+        {
+            continue;
+        }
+        
+        const Fleet& fleet = network.partitions[disasterSet[disIndex].base];
+        
+        cout << "Disaster #" << disIndex;
+        if( network.partitions.size() > 1 )
+        {
+            cout << " (base #" << disasterSet[disIndex].base << ")";
+        }
+        cout << ":" << '\n';
+        
+        if( disIndex < (int)fleet.relays.size()
+                                && fleet.relays[disIndex].head >= 0 )
+        {
+            current = fleet.relays[disIndex].head;
+            
+            while( current >= 0 )
+            {
+                cout << "Drone #" << current << " is at " << fleet.xPos[current] << ", "
+                     << fleet.yPos[current] << ", battery = " << fleet.battery[current]
+                     << "%" << '\n';
+                
+                current = fleet.next[current];
+            }
+        }
+        else
+        {
+            cout << "Covered by other disaster relay" << '\n';
+        }
     }
+
 }
 
 /**
  * @brief Determines which in flight Drone is closest to the Disaster
  *
- * @details Loops through all Drones and finds the minimum distance to Disaster
+ * @details Searches the spatial grid of in flight Drones outward from the
+ *          Disaster instead of scanning the fleet
  *          
  * @param in: fleet
- *            Drone array of all Drones
+ *            Fleet of all Drones
  *
  *            dis
  *            Disaster to find closest Drone to      
@@ -373,36 +829,18 @@ float getDirVector( int x1, int y1, int x2, int y2 )
  *
  * @note None
  */
-int findClosest( const Drone* fleet, const Disaster& dis )
+int findClosest( const Fleet& fleet, const Disaster& dis )
 {
-    int index = 0;
-    int closest = -1;
-    int dist = 1000;
-    int thisDist;
-    
-    for( index = 0; index < FLEET_SIZE; index++ )
-    {
-        if( fleet[index].inFlight )
-        {
-            thisDist = distance( fleet[index].xPos, fleet[index].yPos,
-                                        dis.xPos, dis.yPos );
-            if( thisDist < dist )
-            {
-                dist = thisDist;
-                closest = index;
-            }
-        }
-    }
-    
-    return closest;
+    return gridNearest( fleet, dis.xPos, dis.yPos );
 }
 
 /**
  * @brief Simulator Menu
  *
- * @details User has 5 choices: Generate a new Disaster, print relay network
+ * @details User has 8 choices: Generate a new Disaster, print relay network
  *          information, simulate x minutes of time passing, send a packet,
- *          or quit
+ *          print the relay map, print the instrumentation summary, resolve a
+ *          Disaster, or quit
  *          
  * @param in: None        
  *        
@@ -414,167 +852,284 @@ int getUserChoice()
 {
     int choice = -1;
     
-    while( choice < 0 || choice > 5 )
+    while( choice < 0 || choice > 7 )
     {
-        cout << endl << "Enter 1 to generate new disaster" << endl
-             << "Enter 2 to print relay network information" << endl
-             << "Enter 3 to simulate x minutes of time passing" << endl
-             << "Enter 4 to simulate sending a packet from (x,y)" << endl
-             << "Enter 5 to print relay map (x,y)" << endl
-             << "Enter 0 to quit" << endl;
+        cout << '\n' << "Enter 1 to generate new disaster" << '\n'
+             << "Enter 2 to print relay network information" << '\n'
+             << "Enter 3 to simulate x minutes of time passing" << '\n'
+             << "Enter 4 to simulate sending a packet from (x,y)" << '\n'
+             << "Enter 5 to print relay map (x,y)" << '\n'
+             << "Enter 6 to print instrumentation summary" << '\n'
+             << "Enter 7 to resolve a disaster" << '\n'
+             << "Enter 0 to quit" << '\n';
         
         cin >> choice;
+        if( !cin )
+        {
+            return 0;
+        }
     }
     
     return choice;
 }
    
+/**
+ * @brief Takes input from the console of the number of a Disaster
+ *
+ * @param in: None
+ *
+ * @return int number entered, -1 if none could be read
+ *
+ * @note The number is checked by resolveDisaster
+ */
+int chooseDisaster()
+{
+    int disNum = -1;
+    
+    cout << "Enter number of disaster to resolve: ";
+    if( !( cin >> disNum ) )
+    {
+        return -1;
+    }
+    cout << '\n';
+    
+    return disNum;
+}
+
 /**
  * @brief Simulates x minutes based on user input
  *
- * @details Calls updateBatteries for each simulated minute
+ * @details Hands the minutes to the event engine of every partition, which
+ *          jumps between Drone replacements instead of calling
+ *          updateBatteries for each simulated minute
  *          
- * @param in: fleet
- *            Drone array of all Drones        
+ * @param in: network
+ *            Fleets of all base stations
  *        
  * @return Void 
  *
  * @note None
  */  
-void simulateTime( Drone*& fleet )
+void simulateTime( BaseNetwork& network )
 {
-    int currentTime, endTime;
+    int endTime;
     
     cout << "Enter number of minutes to simulate: ";
     cin >> endTime;
-    cout << endl;
+    cout << '\n';
     
-    for( currentTime = 0; currentTime < endTime; currentTime++ )
-    {
-        updateBatteries( fleet, currentTime );
-    }
+    networkAdvance( network, max( 0, endTime ) );
 }
 
 /**
  * @brief All inFlight drones have their battery drained 1% for each minute in
  *        flight. Charging drones gain 5% battery each minute
  *
- * @details Loops through for every Drone and either decreased or increases
- *          battery. Also calls replaceDrone if neccessary
+ * @details Runs in two phases. First every Drone's battery is decreased or
+ *          increased and the clock advances one minute. Large fleets split
+ *          this phase across fleet.workers threads of fleet.workerPool,
+ *          each collecting the low Drones of its own contiguous range. Then every Drone that was in
+ *          flight and dropped below fleet.lowBattery is passed to replaceDrone in index
+ *          order on the calling thread, so a replacement never sees a half
+ *          updated fleet and the result does not depend on the thread count.
+ *          A Drone that cannot be replaced is passed to repairRelay. Every
+ *          fleet.consolidateEvery minutes consolidateRelays runs last
  *          
  * @param in: fleet
- *            Drone array of all Drones
+ *            Fleet of all Drones
  *
  *            currentTime
  *            Needed for replaceDrone to have correct time reference      
  *        
  * @return void
  *
- * @note None
+ * @note Idle batteries only change through the clock in the idle queue, so
+ *       charging does not touch the queue
  */
-void updateBatteries( Drone*& fleet, const int currentTime )
+void updateBatteries( Fleet& fleet, const int currentTime )
 {
-    int index;
+    INSTRUMENT_SCOPE( PROBE_UPDATE_BATTERIES );
+    int index, part;
+    int parts = partitionCount( fleet.size, fleet.workers );
+    vector< vector<int> >& lowBattery = fleet.scratch.lowBattery;
     
-    for( index = 0; index < FLEET_SIZE; index++ )
+    if( (int)lowBattery.size() < parts )
     {
-        if( fleet[index].inFlight ) //-1% for each minute in flight
+        lowBattery.resize( parts );
+    }
+    for( part = 0; part < parts; part++ )
+    {
+        lowBattery[part].clear();
+    }
+    
+    parallelFor( fleet.workerPool, fleet.size, parts,
+                 [&]( int part, int begin, int end )
+    {
+        tickBatteries( fleet, begin, end, lowBattery[part] );
+    } );
+    
+    fleet.clock++;
+    
+    //parts cover increasing index ranges, so this is index order
+    for( part = 0; part < parts; part++ )
+    {
+        for( index = 0; index < (int)lowBattery[part].size(); index++ )
         {
-            fleet[index].battery--;
-            if( fleet[index].battery < 25 )
+            if( !replaceDrone( lowBattery[part][index], fleet, currentTime )
+                 && !repairRelay( lowBattery[part][index], fleet, currentTime ) )
             {
-                if( !replaceDrone( index, fleet, currentTime ) )
+                logEvent( fleet, EVENT_REPLACE_FAILED, lowBattery[part][index],
+                          -1, -1, -1 );
+                if( fleet.console )
                 {
-                    cout << "No drones available to replace drone #" << fleet[index].droneID;
+                    cout << "No drones available to replace drone #"
+                         << lowBattery[part][index] << '\n';
                 }
             }
         }
-        else //+5% for each minute charging
-        {
-            fleet[index].battery = min( 100, fleet[index].battery + 5 );
-        }
+    }
+    
+    if( fleet.consolidateEvery > 0 && fleet.clock % fleet.consolidateEvery == 0 )
+    {
+        consolidateRelays( fleet, currentTime );
     }
 
 }
 
+/**
+ * @brief Drains or charges the battery of every Drone in a range for one
+ *        minute
+ *
+ * @details In flight Drones lose 1% and are added to lowBattery if they
+ *          drop below fleet.lowBattery, idle Drones gain 5% up to 100%. Only the
+ *          battery and inFlight arrays of the range are touched, so ranges
+ *          can run on separate threads. The work is done by the batteryKernel
+ *          selected for this CPU. Slots of Drones lost from the fleet keep
+ *          the empty battery loseDrone left them with
+ *          
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            begin
+ *            First Drone index of the range
+ *
+ *            end
+ *            One past the last Drone index of the range
+ *
+ *            lowBattery
+ *            Indices of in flight Drones that need replacing are appended
+ *        
+ * @return void
+ *
+ * @note None
+ */
+void tickBatteries( Fleet& fleet, int begin, int end, vector<int>& lowBattery )
+{
+    INSTRUMENT_SCANNED( PROBE_UPDATE_BATTERIES, end - begin );
+    batteryKernel( fleet.battery.data(), fleet.inFlight.data(),
+                   fleet.drones.live.data(), begin, end, fleet.lowBattery,
+                   lowBattery );
+}
+
 /**
  * @brief If neccessary and possible replaces a low battery Drone with a
  *        charged drone from the Command and Control Center
  *
  * @details If a Drone needs to be replaced the new Drone takes its place
- *          in the relay. Also the new Drone is given default values
+ *          in the relay, and any relay attached to the old Drone is attached
+ *          to the new one, as are packets queued at it in the pipeline.
+ *          Also the old Drone returns to the base station and is given
+ *          default values
  *          
  * @param in: index
  *            Index of Drone to check for replacement
  *
  *            fleet
- *            Drone Array of all Drones
+ *            Fleet of all Drones
  *
  *            currentTime
  *            Needed for reference when printing Drone replacement information   
  *        
  * @return bool Evidence of successful Drone replacement
  *
- * @note None
+ * @note O(log n + nearby)
  */
-bool replaceDrone( const int index, Drone*& fleet, const int currentTime )
+bool replaceDrone( const int index, Fleet& fleet, const int currentTime )
 {
+    INSTRUMENT_SCOPE( PROBE_REPLACE_DRONE );
+    vector<int>& nearby = fleet.scratch.nearby;
     int newIndex = highestPower( fleet );
-    Drone* tmp = (&fleet[index]);
+    int neighbor, member;
     
     if( newIndex < 0 )
     {
+        fleet.replaceFailures++;
         return false;
     }
     
-    fleet[newIndex].previous = fleet[index].previous;
-    fleet[newIndex].next = fleet[index].next;
+    fleet.replacements++;
+    fleet.previous[newIndex] = fleet.previous[index];
+    fleet.next[newIndex] = fleet.next[index];
+    
+    neighbor = fleet.previous[index];
+    if( neighbor >= 0 && fleet.next[neighbor] == index )
+    {
+        fleet.next[neighbor] = newIndex;
+    }
+    
+    neighbor = fleet.next[index];
+    if( neighbor >= 0 && fleet.previous[neighbor] == index )
+    {
+        fleet.previous[neighbor] = newIndex;
+    }
     
-    if( tmp->previous != NULL )
+    //relays that attach to the old Drone now hang off the new one, their
+    //heads are within range of it
+    gridWithinRadius( fleet, fleet.xPos[index], fleet.yPos[index], fleet.range,
+                      nearby );
+    for( member = 0; member < (int)nearby.size(); member++ )
     {
-        tmp = tmp->previous;
-        if( tmp->next == &(fleet[index]) )
+        if( fleet.previous[nearby[member]] == index )
         {
-            tmp->next = &(fleet[newIndex]);
+            fleet.previous[nearby[member]] = newIndex;
         }
-        
-        tmp = &(fleet[index]);
     }
     
-    if( tmp->next != NULL )
+    idleRemove( fleet, newIndex );
+    relayReplace( fleet, index, newIndex );
+    pipelineHandOver( fleet, index, newIndex );
+    gridRemove( fleet, index );
+    fleet.inFlight[newIndex] = true;
+    fleet.xPos[newIndex] = fleet.xPos[index];
+    fleet.yPos[newIndex] = fleet.yPos[index];
+    gridInsert( fleet, newIndex );
+    fleet.disNum[newIndex] = fleet.disNum[index];
+    fleet.firstDrone[newIndex] = fleet.firstDrone[index];
+    fleet.inFlight[index] = false;
+    fleet.xPos[index] = fleet.baseX;
+    fleet.yPos[index] = fleet.baseY;
+    fleet.disNum[index] = -1;
+    fleet.firstDrone[index] = false;
+    fleet.previous[index] = -1;
+    fleet.next[index] = -1;
+    idleInsert( fleet, index );
+    
+    logEvent( fleet, EVENT_REPLACED, index, newIndex, fleet.xPos[newIndex],
+              fleet.yPos[newIndex] );
+    
+    if( fleet.console )
     {
-        tmp = tmp->next;
-        if( tmp->previous == &(fleet[index]) )
-        {
-            tmp->previous = &(fleet[newIndex]);
+        cout << "Drone #" << index << " replaced by drone #"
+             << newIndex << " at " << fleet.xPos[newIndex]
+             << ", " << fleet.yPos[newIndex];
+             
+        if( currentTime >= 0 )
+        {      
+            cout << " at time " << currentTime;
         }
         
-        tmp = &(fleet[index]);
-    }
-    
-    fleet[newIndex].inFlight = true;
-    fleet[newIndex].xPos = fleet[index].xPos;
-    fleet[newIndex].yPos = fleet[index].yPos;
-    fleet[newIndex].disNum = fleet[index].disNum;
-    fleet[newIndex].firstDrone = fleet[index].firstDrone;
-    fleet[index].inFlight = false;
-    fleet[index].xPos = 0;
-    fleet[index].yPos = 0;
-    fleet[index].disNum = -1;
-    fleet[index].firstDrone = false;
-    fleet[index].previous = NULL;
-    fleet[index].next = NULL;
-    
-    cout << "Drone #" << fleet[index].droneID << " replaced by drone #"
-         << fleet[newIndex].droneID << " at " << fleet[newIndex].xPos
-         << ", " << fleet[newIndex].yPos;
-         
-    if( currentTime >= 0 )
-    {      
-        cout << " at time " << currentTime;
+        cout << '\n';
     }
-    
-    cout << endl;
          
     return true;
     
@@ -584,67 +1139,114 @@ bool replaceDrone( const int index, Drone*& fleet, const int currentTime )
  * @brief Simulates sending a packet across a relay from Disaster to Command
  *        and Control Center
  *
- * @details Gets user input for where packet needs to be sent from. If possible
- *          sends packet across Drones in relay to Command and Control Center.
- *          Replaces Drones as neccessary as sending packets drains battery
+ * @details Gets user input for where packet needs to be sent from and passes
+ *          it to sendPacketFrom on the partition networkRoute picks
  *          
- * @param in: fleet
- *            Drone array of all Drones        
+ * @param in: network
+ *            Fleets of all base stations
  *        
  * @return bool Evidence of successful packet send
  *
  * @note None
  */
-bool sendPacket( Drone*& fleet )
+bool sendPacket( BaseNetwork& network )
 {
-    int xPos, yPos;
-    int closestDrone;
-    Disaster tmp; //used to hold position as args to findClosest
-    int distToNet;
-    Drone* tmpDrone;
+    int mapSize = network.partitions[0].mapSize;
+    int xPos, yPos, base;
     
-    cout << "Enter x position to send packet from (1-100): ";
-    cin >> tmp.xPos;
-    while( tmp.xPos > 100 || tmp.xPos < 1 )
+    cout << "Enter x position to send packet from (1-" << mapSize << "): ";
+    cin >> xPos;
+    while( xPos > mapSize || xPos < 1 )
     {
-        cout << "Must be between 1 and 100: ";
-        cin >> tmp.xPos;
+        cout << "Must be between 1 and " << mapSize << ": ";
+        cin >> xPos;
     }
-    cout << "Enter y position to send packet from (1-100): ";
-    cin >> tmp.yPos;
-    while( tmp.yPos > 100 || tmp.yPos < 1 )
+    cout << "Enter y position to send packet from (1-" << mapSize << "): ";
+    cin >> yPos;
+    while( yPos > mapSize || yPos < 1 )
     {
-        cout << "Must be between 1 and 100: ";
-        cin >> tmp.yPos;
+        cout << "Must be between 1 and " << mapSize << ": ";
+        cin >> yPos;
     }
     
+    base = networkRoute( network, xPos, yPos );
+    
+    return base >= 0 && sendPacketFrom( network.partitions[base], xPos, yPos );
+}
+
+/**
+ * @brief Sends a packet from the given coordinates across a relay to the
+ *        Command and Control Center
+ *
+ * @details If possible sends packet across Drones in relay to Command and
+ *          Control Center. Replaces Drones as neccessary as sending packets
+ *          drains battery
+ *          
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            xPos
+ *            x coordinate the packet is sent from
+ *
+ *            yPos
+ *            y coordinate the packet is sent from
+ *        
+ * @return bool Evidence of successful packet send
+ *
+ * @note None
+ */
+bool sendPacketFrom( Fleet& fleet, int xPos, int yPos )
+{
+    INSTRUMENT_SCOPE( PROBE_SEND_PACKET );
+    int closestDrone;
+    Disaster tmp; //used to hold position as args to findClosest
+    int current;
+    
+    tmp.xPos = xPos;
+    tmp.yPos = yPos;
     closestDrone = findClosest( fleet, tmp );
     
-    distToNet = distance( fleet[closestDrone].xPos, fleet[closestDrone].yPos,
-                    tmp.xPos, tmp.yPos );
-                    
-    if( distToNet > MAX_CONNECTION_DIST * .95 )
+    if( closestDrone < 0 )
+    {
+        return false;
+    }
+    
+    if( !inReach( fleet, fleet.xPos[closestDrone], fleet.yPos[closestDrone],
+                  tmp.xPos, tmp.yPos ) )
     {
         return false;
     }
     
     else
     {
-        tmpDrone = &(fleet[closestDrone]);
-        cout << endl;
+        current = closestDrone;
+        if( fleet.console )
+        {
+            cout << '\n';
+        }
         
-        while( tmpDrone != NULL )
+        while( current >= 0 )
         {
-            cout << "Packet at drone #" << tmpDrone->droneID << endl;
-            tmpDrone->battery -= 1; //subtract 1% for sending a packet
-            if( tmpDrone->battery < 25 )
+            logEvent( fleet, EVENT_PACKET_HOP, current, -1, fleet.xPos[current],
+                      fleet.yPos[current] );
+            if( fleet.console )
+            {
+                cout << "Packet at drone #" << current << '\n';
+            }
+            INSTRUMENT_SCANNED( PROBE_SEND_PACKET, 1 );
+            relayDrain( fleet, current, 1 ); //subtract 1% for sending a packet
+            if( fleet.battery[current] < fleet.lowBattery )
             {
-                replaceDrone( tmpDrone->droneID, fleet, -1 );
+                replaceDrone( current, fleet, -1 );
             }
-            tmpDrone = tmpDrone->previous;
+            current = fleet.previous[current];
         }
         
-        cout << "Packet received at Command and Control Center" << endl;
+        logEvent( fleet, EVENT_PACKET_DELIVERED, closestDrone, -1, xPos, yPos );
+        if( fleet.console )
+        {
+            cout << "Packet received at Command and Control Center" << '\n';
+        }
         return true;
     }
     
@@ -653,71 +1255,29 @@ bool sendPacket( Drone*& fleet )
 /**
  * @brief Displays the current state of the simulator
  *
- * @details Uses the terminal to display all data
+ * @details Renders the map with renderMap into the caller's frame, then
+ *          hands the whole frame to cout in a single write. Passing the same
+ *          frame each time keeps its buffers from being allocated again
  *          
- * @param in: fleet
- *            Drone array of all Drones
+ * @param in: network
+ *            Fleets of all base stations
  *
  *            disasterSet
  *            Vector containing all disaster data        
+ *
+ *            frame
+ *            Buckets and text buffer to render into
  *        
  * @return void
  *
- * @note None
+ * @note O(fleets + disasters + MAP_DRAW_SIZE^2)
  */
-void printMap(Drone* fleet, vector<Disaster> disasterSet)
+void printMap( const BaseNetwork& network, const vector<Disaster>& disasterSet,
+               MapFrame& frame )
 {
-    int index;
-    int passIndex;
-    int fleetIndex;
-    int disIndex;
-    
-    cout << endl;
-
-    cout << "UAV:" << endl;
-    cout << "#<droneID> :<disaster-attached>" << endl;
-    cout << endl;
-    cout << "Disaster:";
-    cout << "<disasterID> pos: (x,y)" << endl;
-    cout << endl;
-       
-    for( index = 0; index < 101; index++ )
-    {
-        for( passIndex = 0; passIndex < 101; passIndex++ )
-        {
-            for( fleetIndex = 0; fleetIndex < FLEET_SIZE; fleetIndex++ )  
-            {
-                if(fleet[fleetIndex].xPos == index && fleet[fleetIndex].yPos == passIndex )
-                {
-                    if( fleet[fleetIndex].disNum != -1 )
-                    {
-                        cout << "#" << fleet[fleetIndex].droneID << " :" << fleet[fleetIndex].disNum;
-                    }
-                }
-            }
-
-            for( disIndex = 0; disIndex < disasterSet.size(); disIndex++ )
-            {
-                if( disasterSet[disIndex].xPos == index && disasterSet[disIndex].yPos == passIndex )
-                {
-                    cout << "DSTR:" << disasterSet[disIndex].disNum<< " pos:(" << disasterSet[disIndex].xPos << "," 
-                         << disasterSet[disIndex].yPos << ")";
-                }
-            }
-
-            if( index == 0 && passIndex == 0)
-            {
-                cout << "(0,0) " << "Base Station";
-            }
-
-            if( index == 100 && passIndex == 100 )
-            {
-                cout << "(100,100) " << "Max";
-            }
-            cout << " ";
-        }
-        cout << endl;
-    }  
+    renderMap( network.partitions.data(), network.partitions.size(),
+               disasterSet, frame );
+    cout.write( frame.buffer.data(), frame.buffer.size() );
 }
 
 #endif
@@ -15,30 +15,44 @@
 
 // Header Files ///////////////////////////////////////////////////////////////
 
-#include <iostream>
-#include <cmath>
-#include <cstdlib>
+#include <cstdint>
 #include <vector>
-#include "structs.cpp"
+#include "structs.h"
 
 using namespace std;
 
 // Function Prototypes ////////////////////////////////////////////////////////
 
-void generateFleet( Drone*& fleet );
-void makeDisaster( Disaster& dis, const int disCount );
-bool generateRelay( const Disaster& dis, Drone*& fleet );
-int highestPower( const Drone* fleet );
-int distance( int x1, int y1, int x2, int y2 );
-void displayRelay( Drone* fleet, int disCount );
-float getDirVector( int x1, int y1, int x2, int y2 );
-int findClosest( const Drone* fleet, const Disaster& dis );
+void generateFleet( Fleet& fleet, const int fleetSize, const uint64_t seed,
+                    const int baseX = 0, const int baseY = 0 );
+void reserveFleet( Fleet& fleet, int drones, int disasters );
+int addDrone( Fleet& fleet );
+bool loseDrone( const int index, Fleet& fleet, const int currentTime );
+bool setMap( Fleet& fleet, const int mapSize, const int range );
+void makeDisaster( Disaster& dis, const int disCount, const int mapSize );
+bool addDisaster( BaseNetwork& network, vector<Disaster>& disasterSet,
+                  int xPos, int yPos );
+bool resolveDisaster( BaseNetwork& network, vector<Disaster>& disasterSet,
+                      int disNum );
+bool generateRelay( const Disaster& dis, Fleet& fleet );
+bool withinReserve( const Fleet& fleet, int drones );
+int highestPower( Fleet& fleet );
+long long distSquared( int x1, int y1, int x2, int y2 );
+bool inReach( const Fleet& fleet, int x1, int y1, int x2, int y2 );
+bool inRange( const Fleet& fleet, int x1, int y1, int x2, int y2 );
+void displayRelay( const BaseNetwork& network,
+                   const vector<Disaster>& disasterSet );
+int findClosest( const Fleet& fleet, const Disaster& dis );
 int getUserChoice();
-void simulateTime( Drone*& fleet );
-void updateBatteries( Drone*& fleet, const int currentTime );
-bool replaceDrone( const int index, Drone*& fleet, const int currentTime );
-bool sendPacket( Drone*& fleet );
-void printMap(Drone* fleet, vector<Disaster> disasterSet);
+int chooseDisaster();
+void simulateTime( BaseNetwork& network );
+void updateBatteries( Fleet& fleet, const int currentTime );
+void tickBatteries( Fleet& fleet, int begin, int end, vector<int>& lowBattery );
+bool replaceDrone( const int index, Fleet& fleet, const int currentTime );
+bool sendPacket( BaseNetwork& network );
+bool sendPacketFrom( Fleet& fleet, int xPos, int yPos );
+void printMap( const BaseNetwork& network, const vector<Disaster>& disasterSet,
+               MapFrame& frame );
 
 // Terminating precompiler directives  ////////////////////////////////////////
 
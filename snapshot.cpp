@@ -0,0 +1,469 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file snapshot.cpp
+ *
+ * @details Implementation file for simulator snapshots which provides
+ *          function definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef SNAPSHOT_CPP
+#define SNAPSHOT_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "snapshot.h"
+#include "parallel.h"
+#include "pool.h"
+#include "idlequeue.h"
+#include "spatialgrid.h"
+#include "relays.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Returns the size of a snapshot file from its header counts
+ *
+ * @param in: header
+ *            Header of the snapshot
+ *
+ * @return size_t Number of bytes in the file
+ *
+ * @note None
+ */
+static size_t snapshotBytes( const SnapshotHeader& header )
+{
+    return sizeof( SnapshotHeader )
+           + (size_t)header.relayCount * sizeof( SnapshotRelay )
+           + (size_t)header.disasterCount * 3 * sizeof( int32_t )
+           + (size_t)header.fleetSize * ( 6 * sizeof( int32_t ) + 3 );
+}
+
+/**
+ * @brief Copies an array into a mapped file and moves past it
+ *
+ * @param in: at
+ *            Write position in the mapping, advanced past the array
+ *
+ *            data
+ *            First element of the array
+ *
+ *            bytes
+ *            Size of the array
+ *
+ * @return void
+ *
+ * @note None
+ */
+static void putArray( char*& at, const void* data, size_t bytes )
+{
+    memcpy( at, data, bytes );
+    at += bytes;
+}
+
+/**
+ * @brief Copies an array out of a mapped file and moves past it
+ *
+ * @param in: at
+ *            Read position in the mapping, advanced past the array
+ *
+ *            data
+ *            Vector to fill, already sized
+ *
+ * @return void
+ *
+ * @note None
+ */
+template <typename T>
+static void getArray( const char*& at, vector<T>& data )
+{
+    memcpy( data.data(), at, data.size() * sizeof( T ) );
+    at += data.size() * sizeof( T );
+}
+
+/**
+ * @brief Checks that every value of a strided int32_t array in a mapped
+ *        file lies in [low, high)
+ *
+ * @param in: at
+ *            First value of the array
+ *
+ *            count
+ *            Number of values
+ *
+ *            stride
+ *            Bytes from one value to the next
+ *
+ *            low
+ *            Smallest value allowed
+ *
+ *            high
+ *            One past the largest value allowed
+ *
+ * @return bool Evidence that every value is in range
+ *
+ * @note O(count)
+ */
+static bool indicesInRange( const char* at, int count, size_t stride,
+                            int32_t low, int32_t high )
+{
+    int32_t value;
+    int index;
+
+    for( index = 0; index < count; index++ )
+    {
+        memcpy( &value, at + (size_t)index * stride, sizeof( value ) );
+        if( value < low || value >= high )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Checks every Drone and Disaster index stored in a snapshot
+ *
+ * @details Relay heads and tails and the previous and next links must name
+ *          a Drone of the Fleet or be -1. The Disaster numbers of Disasters
+ *          and Drones must name a relay registry entry or be -1. Nothing is
+ *          copied, so a file that fails leaves the state untouched
+ *
+ * @param in: header
+ *            Header of the snapshot, its sizes already checked against the
+ *            file
+ *
+ *            at
+ *            First byte after the header
+ *
+ * @return bool Evidence that every index is in range
+ *
+ * @note O(n)
+ */
+static bool snapshotIndicesValid( const SnapshotHeader& header, const char* at )
+{
+    const char* drones = at + (size_t)header.relayCount * sizeof( SnapshotRelay )
+                         + (size_t)header.disasterCount * 3 * sizeof( int32_t );
+    size_t array = (size_t)header.fleetSize * sizeof( int32_t );
+
+    return indicesInRange( at + offsetof( SnapshotRelay, head ),
+                           header.relayCount, sizeof( SnapshotRelay ), -1,
+                           header.fleetSize )
+           && indicesInRange( at + offsetof( SnapshotRelay, tail ),
+                              header.relayCount, sizeof( SnapshotRelay ), -1,
+                              header.fleetSize )
+           && indicesInRange( at + (size_t)header.relayCount * sizeof( SnapshotRelay )
+                              + 2 * sizeof( int32_t ), header.disasterCount,
+                              3 * sizeof( int32_t ), -1, header.relayCount )
+           && indicesInRange( drones + 3 * array, header.fleetSize,
+                              sizeof( int32_t ), -1, header.relayCount )
+           && indicesInRange( drones + 4 * array, header.fleetSize,
+                              sizeof( int32_t ), -1, header.fleetSize )
+           && indicesInRange( drones + 5 * array, header.fleetSize,
+                              sizeof( int32_t ), -1, header.fleetSize );
+}
+
+/**
+ * @brief Writes the full simulator state to a snapshot file
+ *
+ * @details The file is sized up front, mapped and filled in place. Idle
+ *          batteries are written as their charge at the current clock, so
+ *          the idle queue and grid can be rebuilt from the arrays alone
+ *
+ * @param in: path
+ *            File to write, replaced if it exists
+ *
+ *            fleet
+ *            Fleet of all Drones
+ *
+ *            disasterSet
+ *            Vector containing all disaster data
+ *
+ * @return bool Evidence that the whole snapshot was written
+ *
+ * @note O(n), see SnapshotHeader for the layout
+ */
+bool saveSnapshot( const char* path, const Fleet& fleet,
+                   const vector<Disaster>& disasterSet )
+{
+    SnapshotHeader header;
+    SnapshotRelay relay;
+    vector<int32_t> battery( fleet.battery.begin(), fleet.battery.end() );
+    int32_t position[3];
+    size_t bytes;
+    int index, file;
+    void* mapping;
+    char* at;
+    bool written;
+
+    memset( &header, 0, sizeof( header ) );
+    memcpy( header.magic, SNAPSHOT_MAGIC, sizeof( header.magic ) );
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.fleetSize = fleet.size;
+    header.clock = fleet.clock;
+    header.dronesUsed = fleet.dronesUsed;
+    header.disasterCount = disasterSet.size();
+    header.relayCount = fleet.relays.size();
+    header.baseX = fleet.baseX;
+    header.baseY = fleet.baseY;
+    header.reserve = fleet.reserve;
+    header.mapSize = fleet.mapSize;
+    header.range = fleet.range;
+    header.lowBattery = fleet.lowBattery;
+    header.consolidateEvery = fleet.consolidateEvery;
+    memcpy( header.rngState, fleet.rng.state, sizeof( header.rngState ) );
+    bytes = snapshotBytes( header );
+
+    for( index = 0; index < fleet.size; index++ )
+    {
+        if( !fleet.inFlight[index] )
+        {
+            battery[index] = min( 100, fleet.idle.chargeKey[index]
+                                                    + 5 * fleet.clock );
+        }
+    }
+
+    file = open( path, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+    if( file < 0 )
+    {
+        return false;
+    }
+
+    if( ftruncate( file, bytes ) != 0 )
+    {
+        close( file );
+        return false;
+    }
+
+    mapping = mmap( NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0 );
+    if( mapping == MAP_FAILED )
+    {
+        close( file );
+        return false;
+    }
+
+    at = (char*)mapping;
+    putArray( at, &header, sizeof( header ) );
+
+    for( index = 0; index < header.relayCount; index++ )
+    {
+        relay.head = fleet.relays[index].head;
+        relay.tail = fleet.relays[index].tail;
+        relay.length = fleet.relays[index].length;
+        relay.reserved = 0;
+        relay.batteryKey = fleet.relays[index].batteryKey;
+        putArray( at, &relay, sizeof( relay ) );
+    }
+
+    for( index = 0; index < header.disasterCount; index++ )
+    {
+        position[0] = disasterSet[index].xPos;
+        position[1] = disasterSet[index].yPos;
+        position[2] = disasterSet[index].disNum;
+        putArray( at, position, sizeof( position ) );
+    }
+
+    putArray( at, battery.data(), fleet.size * sizeof( int32_t ) );
+    putArray( at, fleet.xPos.data(), fleet.size * sizeof( int32_t ) );
+    putArray( at, fleet.yPos.data(), fleet.size * sizeof( int32_t ) );
+    putArray( at, fleet.disNum.data(), fleet.size * sizeof( int32_t ) );
+    putArray( at, fleet.previous.data(), fleet.size * sizeof( int32_t ) );
+    putArray( at, fleet.next.data(), fleet.size * sizeof( int32_t ) );
+    putArray( at, fleet.inFlight.data(), fleet.size );
+    putArray( at, fleet.firstDrone.data(), fleet.size );
+    putArray( at, fleet.drones.live.data(), fleet.size );
+
+    written = msync( mapping, bytes, MS_SYNC ) == 0;
+    munmap( mapping, bytes );
+    return close( file ) == 0 && written;
+}
+
+/**
+ * @brief Replaces the simulator state with the contents of a snapshot file
+ *
+ * @details The file is mapped read only and checked against its header,
+ *          and every stored index is range checked, see snapshotIndicesValid,
+ *          before anything is changed, so a bad file leaves the state as it
+ *          was. The drones pool, idle queue, spatial grid and list of relays
+ *          with no Drone of their own are rebuilt from the arrays. workers,
+ *          console and telemetry are reset to their defaults, and the
+ *          replacement counters to zero, like generateFleet does. A snapshot
+ *          holds a single Fleet, so every Disaster is served by partition 0
+ *
+ * @param in: path
+ *            File to read
+ *
+ *            fleet
+ *            Fleet replaced by the snapshot
+ *
+ *            disasterSet
+ *            Vector replaced by the snapshot disasters
+ *
+ * @return bool Evidence that the snapshot was valid and loaded
+ *
+ * @note O(n)
+ */
+bool loadSnapshot( const char* path, Fleet& fleet,
+                   vector<Disaster>& disasterSet )
+{
+    SnapshotHeader header;
+    SnapshotRelay relay;
+    int32_t position[3];
+    vector<unsigned char> inService;
+    struct stat info;
+    int index, file;
+    void* mapping;
+    const char* at;
+    bool valid;
+
+    file = open( path, O_RDONLY );
+    if( file < 0 )
+    {
+        return false;
+    }
+
+    if( fstat( file, &info ) != 0 || info.st_size < (off_t)sizeof( header ) )
+    {
+        close( file );
+        return false;
+    }
+
+    mapping = mmap( NULL, info.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+    close( file );
+    if( mapping == MAP_FAILED )
+    {
+        return false;
+    }
+
+    at = (const char*)mapping;
+    memcpy( &header, at, sizeof( header ) );
+    at += sizeof( header );
+
+    valid = memcmp( header.magic, SNAPSHOT_MAGIC, sizeof( header.magic ) ) == 0
+            && header.version == SNAPSHOT_VERSION
+            && header.byteOrder == SNAPSHOT_BYTE_ORDER
+            && header.fleetSize > 0 && header.disasterCount >= 0
+            && header.relayCount >= 0 && header.mapSize > 0
+            && header.range >= MIN_RANGE && header.lowBattery >= 0
+            && header.consolidateEvery >= 0
+            && snapshotBytes( header ) == (size_t)info.st_size
+            && snapshotIndicesValid( header, at );
+
+    if( !valid )
+    {
+        munmap( mapping, info.st_size );
+        return false;
+    }
+
+    madvise( mapping, info.st_size, MADV_SEQUENTIAL );
+
+    fleet.relays.resize( header.relayCount );
+    for( index = 0; index < header.relayCount; index++ )
+    {
+        memcpy( &relay, at, sizeof( relay ) );
+        at += sizeof( relay );
+        fleet.relays[index].head = relay.head;
+        fleet.relays[index].tail = relay.tail;
+        fleet.relays[index].length = relay.length;
+        fleet.relays[index].batteryKey = relay.batteryKey;
+        fleet.relays[index].xPos = -1;
+        fleet.relays[index].yPos = -1;
+    }
+
+    disasterSet.resize( header.disasterCount );
+    for( index = 0; index < header.disasterCount; index++ )
+    {
+        memcpy( position, at, sizeof( position ) );
+        at += sizeof( position );
+        disasterSet[index].xPos = position[0];
+        disasterSet[index].yPos = position[1];
+        disasterSet[index].disNum = position[2];
+        disasterSet[index].base = 0;
+
+        if( position[2] >= 0 )
+        {
+            fleet.relays[position[2]].xPos = position[0];
+            fleet.relays[position[2]].yPos = position[1];
+        }
+    }
+
+    fleet.size = header.fleetSize;
+    fleet.battery.resize( fleet.size );
+    fleet.xPos.resize( fleet.size );
+    fleet.yPos.resize( fleet.size );
+    fleet.disNum.resize( fleet.size );
+    fleet.previous.resize( fleet.size );
+    fleet.next.resize( fleet.size );
+    fleet.inFlight.resize( fleet.size );
+    fleet.firstDrone.resize( fleet.size );
+    inService.resize( fleet.size );
+    getArray( at, fleet.battery );
+    getArray( at, fleet.xPos );
+    getArray( at, fleet.yPos );
+    getArray( at, fleet.disNum );
+    getArray( at, fleet.previous );
+    getArray( at, fleet.next );
+    getArray( at, fleet.inFlight );
+    getArray( at, fleet.firstDrone );
+    getArray( at, inService );
+    munmap( mapping, info.st_size );
+
+    fleet.clock = header.clock;
+    fleet.workers = defaultWorkers();
+    fleet.console = true;
+    fleet.telemetry = NULL;
+    fleet.pipeline = NULL;
+    fleet.baseX = header.baseX;
+    fleet.baseY = header.baseY;
+    fleet.reserve = header.reserve;
+    fleet.mapSize = header.mapSize;
+    fleet.range = header.range;
+    fleet.lowBattery = header.lowBattery;
+    fleet.consolidateEvery = header.consolidateEvery;
+    memcpy( fleet.rng.state, header.rngState, sizeof( fleet.rng.state ) );
+    fleet.dronesUsed = header.dronesUsed;
+    fleet.replacements = 0;
+    fleet.replaceFailures = 0;
+    fleet.repairs = 0;
+    fleet.consolidated = 0;
+    poolReset( fleet.drones, fleet.size );
+    for( index = fleet.size - 1; index >= 0; index-- )
+    {
+        if( !inService[index] )
+        {
+            poolRelease( fleet.drones, index );
+        }
+    }
+    fleet.drones.peak = fleet.drones.used;
+    fleet.shared.clear();
+    for( index = 0; index < header.relayCount; index++ )
+    {
+        if( fleet.relays[index].length == 0 && fleet.relays[index].xPos >= 0 )
+        {
+            relayShare( fleet, index );
+        }
+    }
+    idleBuild( fleet );
+    gridBuild( fleet );
+
+    return true;
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
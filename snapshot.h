@@ -0,0 +1,87 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file snapshot.h
+ *
+ * @details Header file for simulator snapshots which provides prototypes for
+ *          saving and restoring the full simulator state
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Global Constants ///////////////////////////////////////////////////////////
+
+static const char SNAPSHOT_MAGIC[8] = { 'D', 'R', 'N', 'S', 'N', 'A', 'P', '\0' };
+static const uint32_t SNAPSHOT_VERSION = 7;
+static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+// Struct Definitions /////////////////////////////////////////////////////////
+
+/**
+ * @brief SnapshotHeader struct starts every snapshot file
+ *
+ * @details The counts give the length of each section that follows, in
+ *          order: relays, disasters, the int fleet arrays (battery, xPos,
+ *          yPos, disNum, previous, next) and the byte fleet arrays (inFlight,
+ *          firstDrone, inService). Relay links are Drone indices, -1 for
+ *          none, a resolved Disaster keeps its slot with disaster number -1
+ *          and a lost Drone its slot with inService 0. Version 2 added the
+ *          base station and reserve of the Fleet, version 3 the map size and
+ *          range, version 4 the replacement threshold, version 5 the random
+ *          number generator state, version 6 the relay consolidation
+ *          interval and version 7 the Drones in service
+ */
+struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder; //SNAPSHOT_BYTE_ORDER as written by the saving host
+    int32_t fleetSize;
+    int32_t clock;
+    int32_t dronesUsed;
+    int32_t disasterCount;
+    int32_t relayCount;
+    int32_t baseX;
+    int32_t baseY;
+    int32_t reserve;
+    int32_t mapSize;
+    int32_t range;
+    int32_t lowBattery;
+    int32_t consolidateEvery; //also keeps rngState 8 byte aligned
+    uint64_t rngState[4];
+};
+
+/**
+ * @brief SnapshotRelay struct is the file layout of one Relay
+ */
+struct SnapshotRelay
+{
+    int32_t head;
+    int32_t tail;
+    int32_t length;
+    int32_t reserved;
+    int64_t batteryKey;
+};
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+bool saveSnapshot( const char* path, const Fleet& fleet,
+                   const vector<Disaster>& disasterSet );
+bool loadSnapshot( const char* path, Fleet& fleet,
+                   vector<Disaster>& disasterSet );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,311 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file spatialgrid.cpp
+ *
+ * @details Implementation file for the spatial grid which provides function
+ *          definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef SPATIALGRID_CPP
+#define SPATIALGRID_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+#include "spatialgrid.h"
+#include "kernels.h"
+#include "instrument.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Returns the grid column or row holding a coordinate
+ *
+ * @details Coordinates outside of the map are clamped to the border cells,
+ *          which can only make cells look closer than they are, so the ring
+ *          bounds used by gridNearest stay valid. The coordinate is 64 bits
+ *          and clamped before it is narrowed, so a query box reaching past
+ *          the int range still lands on the border cells
+ *
+ * @param in: grid
+ *            Grid to look in
+ *
+ *            pos
+ *            x or y coordinate, may lie outside the map
+ *
+ *            limit
+ *            Number of columns or rows in the grid
+ *
+ * @return int column or row of the coordinate
+ *
+ * @note None
+ */
+static int gridCell( const SpatialGrid& grid, long long pos, int limit )
+{
+    if( pos < 0 )
+    {
+        return 0;
+    }
+
+    return (int)min( pos / grid.cellSize, (long long)limit - 1 );
+}
+
+/**
+ * @brief Sizes the grid over the map and indexes every in flight Drone
+ *
+ * @details Cells are fleet.range units wide, which suits radius queries,
+ *          enough to cover 0-fleet.mapSize on both axes. On a map too big
+ *          for GRID_MAX_SIDE cells of that width the cells are widened
+ *          instead, which keeps the grid small at the cost of scanning more
+ *          Drones per cell
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ * @return void
+ *
+ * @note Used by generateFleet and setMap, O(n + cells)
+ */
+void gridBuild( Fleet& fleet )
+{
+    SpatialGrid& grid = fleet.airborne;
+    int index;
+
+    grid.cellSize = max( fleet.range, fleet.mapSize / GRID_MAX_SIDE + 1 );
+    grid.columns = fleet.mapSize / grid.cellSize + 1;
+    grid.rows = fleet.mapSize / grid.cellSize + 1;
+    grid.count = 0;
+    grid.cells.assign( grid.columns * grid.rows, GridCell() );
+    grid.cellOf.assign( fleet.size, -1 );
+    grid.slot.assign( fleet.size, -1 );
+
+    for( index = 0; index < fleet.size; index++ )
+    {
+        if( fleet.inFlight[index] )
+        {
+            gridInsert( fleet, index );
+        }
+    }
+}
+
+/**
+ * @brief Adds a Drone to the cell holding its current position
+ *
+ * @details O(1)
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            Index of the Drone to add
+ *
+ * @return void
+ *
+ * @note Call after the Drone's position is set
+ */
+void gridInsert( Fleet& fleet, int index )
+{
+    SpatialGrid& grid = fleet.airborne;
+    int cell = gridCell( grid, fleet.yPos[index], grid.rows ) * grid.columns
+                    + gridCell( grid, fleet.xPos[index], grid.columns );
+
+    grid.cellOf[index] = cell;
+    grid.slot[index] = grid.cells[cell].drones.size();
+    grid.cells[cell].drones.push_back( index );
+    grid.cells[cell].xPos.push_back( fleet.xPos[index] );
+    grid.cells[cell].yPos.push_back( fleet.yPos[index] );
+    grid.count++;
+}
+
+/**
+ * @brief Removes a Drone from its cell if it is indexed
+ *
+ * @details The last Drone in the cell takes the freed slot. O(1)
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            Index of the Drone to remove
+ *
+ * @return void
+ *
+ * @note Call before the Drone's position is reset
+ */
+void gridRemove( Fleet& fleet, int index )
+{
+    SpatialGrid& grid = fleet.airborne;
+    int cell = grid.cellOf[index];
+    int slot, last;
+
+    if( cell < 0 )
+    {
+        return;
+    }
+
+    GridCell& members = grid.cells[cell];
+    slot = grid.slot[index];
+    last = members.drones.size() - 1;
+    members.drones[slot] = members.drones[last];
+    members.xPos[slot] = members.xPos[last];
+    members.yPos[slot] = members.yPos[last];
+    grid.slot[members.drones[slot]] = slot;
+    members.drones.pop_back();
+    members.xPos.pop_back();
+    members.yPos.pop_back();
+    grid.cellOf[index] = -1;
+    grid.slot[index] = -1;
+    grid.count--;
+}
+
+/**
+ * @brief Finds the in flight Drone closest to a point
+ *
+ * @details Visits rings of cells around the point's cell, nearest first,
+ *          and stops once no cell in the next ring can hold a Drone as
+ *          close as the best one found. Each cell is scanned by the selected
+ *          nearestKernel, comparing squared distances so no sqrt is taken.
+ *          Ties go to the lowest index, like a scan over the whole fleet
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            xPos
+ *            x coordinate of the point
+ *
+ *            yPos
+ *            y coordinate of the point
+ *
+ * @return int index of the closest Drone, -1 if none is in flight
+ *
+ * @note None
+ */
+int gridNearest( const Fleet& fleet, int xPos, int yPos )
+{
+    const SpatialGrid& grid = fleet.airborne;
+    int column = gridCell( grid, xPos, grid.columns );
+    int row = gridCell( grid, yPos, grid.rows );
+    int maxRing = max( grid.columns, grid.rows );
+    int ring, cellRow, cellColumn, step;
+    long long bound;
+    int closest = -1;
+    long long dist = LLONG_MAX; //squared
+    INSTRUMENT_SCOPE( PROBE_FIND_CLOSEST );
+
+    if( grid.count == 0 )
+    {
+        return -1;
+    }
+
+    for( ring = 0; ring < maxRing; ring++ )
+    {
+        //every Drone in this ring is more than (ring - 1) cells away
+        bound = (long long)( ring - 1 ) * grid.cellSize;
+        if( closest >= 0 && ring > 0 && dist <= bound * bound )
+        {
+            break;
+        }
+
+        for( cellRow = row - ring; cellRow <= row + ring; cellRow++ )
+        {
+            if( cellRow < 0 || cellRow >= grid.rows )
+            {
+                continue;
+            }
+
+            //rows inside the ring only have cells on its left and right edge
+            step = ( cellRow == row - ring || cellRow == row + ring )
+                        ? 1 : max( 1, 2 * ring );
+
+            for( cellColumn = column - ring; cellColumn <= column + ring;
+                                                    cellColumn += step )
+            {
+                if( cellColumn < 0 || cellColumn >= grid.columns )
+                {
+                    continue;
+                }
+
+                const GridCell& cell =
+                            grid.cells[cellRow * grid.columns + cellColumn];
+
+                INSTRUMENT_SCANNED( PROBE_FIND_CLOSEST, cell.drones.size() );
+                nearestKernel( cell.xPos.data(), cell.yPos.data(),
+                               cell.drones.data(), cell.drones.size(),
+                               xPos, yPos, dist, closest );
+            }
+        }
+    }
+
+    return closest;
+}
+
+/**
+ * @brief Collects every in flight Drone within a radius of a point
+ *
+ * @details Only the cells overlapping the bounding box of the circle are
+ *          visited, and distances are compared squared. The box is worked
+ *          out in 64 bits, so any radius up to INT_MAX is safe
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            xPos
+ *            x coordinate of the point
+ *
+ *            yPos
+ *            y coordinate of the point
+ *
+ *            radius
+ *            Maximum distance, usually fleet.range
+ *
+ *            found
+ *            Cleared and filled with the indices of the Drones in range
+ *
+ * @return void
+ *
+ * @note None
+ */
+void gridWithinRadius( const Fleet& fleet, int xPos, int yPos, int radius,
+                                                        vector<int>& found )
+{
+    const SpatialGrid& grid = fleet.airborne;
+    int firstColumn = gridCell( grid, (long long)xPos - radius, grid.columns );
+    int lastColumn = gridCell( grid, (long long)xPos + radius, grid.columns );
+    int firstRow = gridCell( grid, (long long)yPos - radius, grid.rows );
+    int lastRow = gridCell( grid, (long long)yPos + radius, grid.rows );
+    int cellRow, cellColumn, member;
+    long long x, y;
+
+    found.clear();
+
+    for( cellRow = firstRow; cellRow <= lastRow; cellRow++ )
+    {
+        for( cellColumn = firstColumn; cellColumn <= lastColumn; cellColumn++ )
+        {
+            const GridCell& cell =
+                        grid.cells[cellRow * grid.columns + cellColumn];
+
+            for( member = 0; member < (int)cell.drones.size(); member++ )
+            {
+                x = (long long)cell.xPos[member] - xPos;
+                y = (long long)cell.yPos[member] - yPos;
+                if( x * x + y * y <= (long long)radius * radius )
+                {
+                    found.push_back( cell.drones[member] );
+                }
+            }
+        }
+    }
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
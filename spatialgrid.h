@@ -0,0 +1,38 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file spatialgrid.h
+ *
+ * @details Header file for the spatial grid which provides prototypes for
+ *          the nearest and radius queries over in flight Drones
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Global Constants ///////////////////////////////////////////////////////////
+
+static const int GRID_MAX_SIDE = 256; //most cells along either axis
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+void gridBuild( Fleet& fleet );
+void gridInsert( Fleet& fleet, int index );
+void gridRemove( Fleet& fleet, int index );
+int gridNearest( const Fleet& fleet, int xPos, int yPos );
+void gridWithinRadius( const Fleet& fleet, int xPos, int yPos, int radius,
+                                                        vector<int>& found );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
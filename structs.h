@@ -0,0 +1,414 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file structs.h
+ *
+ * @details Contains definitions for all structs used in simulator
+ *
+ * @note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef STRUCTS_H
+#define STRUCTS_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Global Constants ///////////////////////////////////////////////////////////
+
+static const int DEFAULT_FLEET_SIZE = 20;
+static const int DEFAULT_RANGE = 20; //longest link between two Drones
+static const int MIN_RANGE = 2; //shortest range that can space a diagonal relay
+static const int DEFAULT_MAP_SIZE = 100;
+static const double REACH_MARGIN = .95; //packets enter from within 95% of range
+static const int DEFAULT_LOW_BATTERY = 25; //percent below which Drones are replaced
+static const int DEFAULT_RESERVE = 20; //percent of a Fleet kept at its base
+static const int DEFAULT_CONSOLIDATE_EVERY = 0; //minutes between relay consolidations, 0 for never
+static const int DEFAULT_HOP_TICKS = 1; //ticks a packet takes to cross one link
+static const int DEFAULT_QUEUE_CAPACITY = 64; //packets each Drone can hold
+static const int DEFAULT_SEND_RATE = 8; //packets each Drone sends per tick
+static const int DEFAULT_TICKS_PER_MINUTE = 60;
+static const int DEFAULT_PACKETS_PER_PERCENT = 1; //packets sent per 1% of battery, as sendPacket
+
+// Struct Definitions /////////////////////////////////////////////////////////
+
+/**
+ * @brief DroneHeap struct is an indexed binary heap of Drone indices
+ *
+ * @details The position array maps every Drone index to its slot in the
+ *          heap (-1 when the Drone is not in the heap) so that any Drone
+ *          can be removed in O(log n) without searching for it
+ */ 
+struct DroneHeap
+{
+    vector<int> nodes;
+    vector<int> position;
+};
+
+/**
+ * @brief IdleQueue struct orders every Drone that is not in flight by
+ *        battery so the most charged Drone is found without a fleet scan
+ *
+ * @details Idle Drones gain 5% each minute, so instead of a battery value a
+ *          charge key (battery minus 5% per minute already on the clock when
+ *          the Drone landed) is stored. The key never changes while the Drone
+ *          charges, and battery = min( 100, key + 5 * clock ). Drones whose
+ *          battery has reached 100% are moved to the charged heap, which is
+ *          ordered by index to keep the lowest index first on ties
+ */ 
+struct IdleQueue
+{
+    DroneHeap charging; //highest charge key first
+    DroneHeap charged; //fully charged, lowest index first
+    vector<int> chargeKey;
+};
+
+/**
+ * @brief GridCell struct holds the in flight Drones inside one cell of a
+ *        SpatialGrid
+ *
+ * @details The Drone indices and a copy of their coordinates are kept in
+ *          parallel contiguous arrays so distance kernels can stream them
+ */ 
+struct GridCell
+{
+    vector<int> drones;
+    vector<int> xPos;
+    vector<int> yPos;
+};
+
+/**
+ * @brief SpatialGrid struct buckets in flight Drones by position so nearest
+ *        and radius queries only visit nearby cells
+ *
+ * @details The map is split into square cells of cellSize units stored row
+ *          by row. Each cell keeps a contiguous list of the Drones inside it
+ *          and slot maps every Drone to its place in that list (-1 when the
+ *          Drone is not indexed), so insert and remove are O(1)
+ */ 
+struct SpatialGrid
+{
+    int cellSize;
+    int columns;
+    int rows;
+    int count;
+    vector<GridCell> cells;
+    vector<int> cellOf;
+    vector<int> slot;
+};
+
+struct Telemetry; //see telemetry.h
+struct PacketPipeline; //see below
+
+/**
+ * @brief Rng struct is the state of a xoshiro256** random number generator
+ *
+ * @details Every Fleet owns one, so runs can be repeated from a seed and
+ *          Fleets on separate threads never share random state. See rng.h
+ */ 
+struct Rng
+{
+    uint64_t state[4];
+};
+
+/**
+ * @brief Relay struct is the registry entry for the relay of one Disaster
+ *
+ * @details head is the Drone closest to the base station and tail the one
+ *          closest to the Disaster, both -1 when the Disaster is covered by
+ *          another relay. batteryKey is the sum of battery + clock over the
+ *          relay, which stays fixed while time passes, so the total battery
+ *          is batteryKey - length * clock. xPos and yPos are the Disaster
+ *          served, -1 until the relay is established
+ */ 
+struct Relay
+{
+    int head;
+    int tail;
+    int length;
+    long batteryKey;
+    int xPos;
+    int yPos;
+};
+
+/**
+ * @brief RelayPlan struct holds the result of planning a relay
+ *
+ * @details attach is the in flight Drone the relay hangs off, -1 for the
+ *          base station. xPos and yPos hold the position of each new Drone,
+ *          from the attachment point towards the Disaster. found is scratch
+ *          space for planRelay, kept so planning again does not allocate
+ */ 
+struct RelayPlan
+{
+    int attach;
+    int hops; //Drones a packet from the Disaster crosses to reach the base
+    vector<int> xPos;
+    vector<int> yPos;
+    vector<int> found; //candidate attachment points
+};
+
+/**
+ * @brief SlotPool struct hands out stable indices from a free list
+ *
+ * @details A slot is an index into arrays kept by the owner of the pool. A
+ *          released slot goes on the free list and is handed out again
+ *          before a new one is added at the end, most recently released
+ *          first, so indices stay stable and the owner's arrays only grow
+ *          when every slot is in use. See pool.h
+ */ 
+struct SlotPool
+{
+    vector<unsigned char> live; //1 for every slot in use, by index
+    vector<int> freeSlots; //released slots, the next one to hand out last
+    int used; //slots in use
+    int peak; //most slots in use at once
+    long growths; //slots added past the reserved capacity
+};
+
+/**
+ * @brief FleetScratch struct holds the working space of the Fleet functions
+ *        that run over and over during a simulation
+ *
+ * @details Each vector is cleared or resized by the function that uses it
+ *          and keeps its capacity, so once a run has warmed up replacing,
+ *          repairing, consolidating and tearing down relays or advancing
+ *          time does not allocate
+ */ 
+struct FleetScratch
+{
+    vector<int> nearby; //grid queries of repairRelay and teardownRelay
+    vector<int> children; //repairRelay
+    vector<int> parents;
+    vector<int> members; //consolidateRelays
+    vector<int> flightKey; //advanceTime
+    vector<int> due;
+    vector< pair<int, int> > events; //advanceTime, a heap, see EventQueue
+    vector< vector<int> > lowBattery; //updateBatteries, one per part
+    RelayPlan plan; //generateRelay and consolidateRelays
+};
+
+/**
+ * @brief WorkerPool struct holds worker threads that stay parked between
+ *        parallelFor calls
+ *
+ * @details Thread t runs part t + 1 of every round and the calling thread
+ *          runs part 0. A round starts when round is incremented and ends
+ *          once running is back to 0. The threads are started the first time
+ *          a round needs them and joined when the pool is destroyed, see
+ *          parallel.cpp
+ */ 
+struct WorkerPool
+{
+    vector<thread> threads;
+    mutex submit; //one round at a time, copies of a Fleet share the pool
+    mutex lock; //guards the fields below
+    condition_variable wake; //a round started or the pool is stopping
+    condition_variable done; //the last part of a round finished
+    const function<void( int part, int begin, int end )>* body;
+    int count; //items of the current round
+    int parts;
+    long round;
+    int running; //parts of the round still running on the threads
+    bool stopping;
+
+    WorkerPool();
+    ~WorkerPool();
+};
+
+/**
+ * @brief Fleet struct is used to hold all relative data for every Drone in
+ *        the simulator
+ *
+ * @details Drone data is stored as a structure of arrays: each field has its
+ *          own contiguous array indexed by the drone identifier, so a scan
+ *          over the fleet only touches the fields it needs. Relays are
+ *          established through the previous and next arrays, which hold the
+ *          index of the neighboring Drone or -1 when there is none.
+ *          Positions are whole map units, and a unit is whatever the map is
+ *          configured for, a 100km map with 1m units has mapSize 100000.
+ *          The arrays hold one slot per index the drones pool has handed
+ *          out. A lost Drone keeps its slot, out of the idle queue and the
+ *          grid, until addDrone gives it to a new Drone
+ */ 
+struct Fleet
+{
+    int size; //slots in the Drone arrays, drones.used are in service
+    vector<int> battery;
+    vector<int> xPos;
+    vector<int> yPos;
+    vector<int> disNum; //number of disaster linking to
+    vector<unsigned char> inFlight;
+    vector<unsigned char> firstDrone; //closest to base station
+    vector<int> previous;
+    vector<int> next;
+    int clock; //minutes simulated so far
+    int mapSize; //map spans 0-mapSize units on both axes
+    int range; //longest link between two Drones, in map units
+    int baseX; //Command and Control Center the Fleet flies from
+    int baseY;
+    int reserve; //percent of Drones kept at the base to replace others
+    int lowBattery; //in flight Drones below this percent are replaced
+    int consolidateEvery; //minutes between consolidateRelays passes, 0 for never
+    int dronesUsed; //Drones sent out on relays
+    long replacements; //successful replaceDrone calls
+    long replaceFailures; //replaceDrone calls with no charged Drone
+    long repairs; //relays repaired around a Drone that could not be replaced
+    long consolidated; //Drones landed by consolidateRelays
+    int workers; //threads used by updateBatteries
+    shared_ptr<WorkerPool> workerPool; //started by the first parallel minute
+    IdleQueue idle;
+    SpatialGrid airborne; //in flight Drones by position
+    vector<Relay> relays; //by disaster number
+    vector<int> shared; //established relays with no Drone of their own
+    SlotPool drones; //in service Drones, a lost Drone's index is reused
+    FleetScratch scratch;
+    Rng rng; //starting batteries and other chance events
+    bool console; //event lines are printed to cout
+    Telemetry* telemetry; //event log, NULL when not recording
+    PacketPipeline* pipeline; //packets queued at the Drones, NULL when none
+};
+
+/**
+ * @brief Disaster struct is used to hold all relative data for each Disaster
+ * 	 	  in the simulator
+ *
+ * @details Uses primitive data type fields to store data such as the disaster
+ *  	 	identifier and position
+ */ 
+struct Disaster
+{
+    int xPos;
+    int yPos;
+    int disNum; //index in the Disaster set, -1 once resolved
+    int base; //partition of the BaseNetwork serving the Disaster
+};
+
+/**
+ * @brief BaseNetwork struct holds one Fleet partition per Command and
+ *        Control Center
+ *
+ * @details Each partition is a complete Fleet with its own base, reserve,
+ *          idle queue, grid and relays, and its Drone indices are its own.
+ *          Nothing is shared between partitions, so they can be simulated
+ *          on separate threads. Disaster numbers are shared: the relay of a
+ *          Disaster is kept by the partition named in its base field
+ */ 
+struct BaseNetwork
+{
+    vector<Fleet> partitions;
+    int workers; //threads used to advance partitions side by side
+    shared_ptr<WorkerPool> workerPool; //started by the first parallel advance
+    SlotPool disasters; //Disaster numbers, a resolved Disaster's is reused
+    RelayPlan plan; //scratch for networkCheapest
+};
+
+/**
+ * @brief PacketBatch struct holds the scratch space and results of sending
+ *        a batch of packets
+ *
+ * @details The scratch vectors are reused from batch to batch so a batch
+ *          does not allocate once they have grown. The counters and hop
+ *          histogram add up over every batch sent with the struct
+ */ 
+struct PacketBatch
+{
+    vector<int> load; //packets relayed by each Drone this batch
+    vector<int> entries; //Drones that packets entered the relays at
+    vector<int> entryCounts; //packets that entered at each of entries
+    vector<int> touched; //Drones with a nonzero load
+    vector<int> lowBattery; //touched Drones that need replacing
+    vector<int> route; //partition each packet enters, see networkSendBatch
+    vector<int> sourceXPos; //packets routed to one partition
+    vector<int> sourceYPos;
+    vector<long> hopHistogram; //packets by number of Drones crossed
+    long delivered;
+    long dropped;
+    long replaced;
+    double seconds;
+};
+
+/**
+ * @brief PacketPipeline struct holds the packets travelling through the
+ *        relays of one Fleet and the statistics of their trip
+ *
+ * @details Time is counted in ticks, ticksPerMinute to a minute of the
+ *          Fleet's clock. Every Drone has a first in first out queue of up
+ *          to queueCapacity packets, linked through the packets from
+ *          queueHead to queueTail. A packet joins the queue of the next
+ *          Drone as it is sent and can be sent on once readyTick has come,
+ *          hopTicks later, and each Drone sends at most sendRate packets a
+ *          tick. Packets are
+ *          slots of the packets pool, so a run with a steady number in
+ *          flight does not allocate. active lists the Drones whose queue
+ *          held a packet this tick, so a tick only visits those. latency
+ *          counts delivered packets by ticks from the source to the base
+ *          station
+ */ 
+struct PacketPipeline
+{
+    int hopTicks;
+    int queueCapacity;
+    int sendRate;
+    int ticksPerMinute;
+    int packetsPerPercent; //0 for packets that cost no battery
+    long tick; //ticks run so far
+    SlotPool packets;
+    vector<long> sentTick; //by packet
+    vector<long> readyTick;
+    vector<int> link; //by packet, the next packet in its queue or -1
+    vector<int> queueHead; //by Drone
+    vector<int> queueTail;
+    vector<int> queueLength;
+    vector<int> peakDepth;
+    vector<int> active; //Drones with a queue, see listed
+    vector<unsigned char> listed; //by Drone, 1 while in active
+    vector<long> sent; //packets sent by each Drone
+    vector<long> drops; //packets dropped at each Drone
+    vector<long> latency;
+    vector<int> lowBattery; //Drones to replace after a tick
+    long injected; //packets that entered a relay or were dropped entering
+    long delivered;
+    long dropped; //full queue, or queued at a Drone that landed
+    long unreachable; //no Drone in reach of the source
+    long queued; //packets in the queues now
+    long depthTotal; //queued summed over every tick, for the average
+};
+
+/**
+ * @brief MapFrame struct holds the buckets and text buffer used to render
+ *        the relay map
+ *
+ * @details droneStart, disasterStart and baseStart hold one offset per drawn
+ *          position plus one, into droneOrder, disasterOrder and baseOrder.
+ *          droneBase holds the partition of each droneOrder entry. Every
+ *          vector and the buffer keep their capacity, so redrawing a map of
+ *          the same size does not allocate
+ */ 
+struct MapFrame
+{
+    vector<int> droneStart;
+    vector<int> droneOrder; //attached Drones by position, then index
+    vector<int> droneBase;
+    vector<int> disasterStart;
+    vector<int> disasterOrder; //Disasters by position, then set order
+    vector<int> baseStart;
+    vector<int> baseOrder; //base stations by position, then partition
+    string buffer;
+};
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
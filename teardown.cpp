@@ -0,0 +1,214 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file teardown.cpp
+ *
+ * @details Implementation file for relay teardown which provides function
+ *          definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef TEARDOWN_CPP
+#define TEARDOWN_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "teardown.h"
+#include "idlequeue.h"
+#include "spatialgrid.h"
+#include "relays.h"
+#include "telemetry.h"
+#include "simulator.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Finds what still needs a Drone of a relay being torn down
+ *
+ * @details A Drone is needed while the head of another relay hangs off it,
+ *          or while it is the only Drone in reach of a Disaster that has no
+ *          relay of its own. The Drone is taken out of the grid for the
+ *          check and left out if nothing needs it
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            In flight Drone of the relay, the tail of what is left of it
+ *
+ *            nearby
+ *            Scratch space for the grid query
+ *
+ * @return int Disaster number of the relay that needs the Drone, -1 if
+ *         nothing does
+ *
+ * @note O(nearby + shared relays)
+ */
+static int neededBy( Fleet& fleet, int index, vector<int>& nearby )
+{
+    int member, site, nearest;
+    const Relay* relay;
+
+    //children are within range of the Drone they hang off
+    gridWithinRadius( fleet, fleet.xPos[index], fleet.yPos[index], fleet.range,
+                      nearby );
+    for( member = 0; member < (int)nearby.size(); member++ )
+    {
+        if( fleet.previous[nearby[member]] == index
+             && fleet.disNum[nearby[member]] != fleet.disNum[index] )
+        {
+            return fleet.disNum[nearby[member]];
+        }
+    }
+
+    gridRemove( fleet, index );
+    for( member = 0; member < (int)fleet.shared.size(); member++ )
+    {
+        site = fleet.shared[member];
+        relay = &fleet.relays[site];
+        if( site == fleet.disNum[index]
+             || !inReach( fleet, fleet.xPos[index], fleet.yPos[index],
+                          relay->xPos, relay->yPos ) )
+        {
+            continue;
+        }
+
+        nearest = gridNearest( fleet, relay->xPos, relay->yPos );
+        if( nearest < 0 || !inReach( fleet, fleet.xPos[nearest],
+                                     fleet.yPos[nearest], relay->xPos,
+                                     relay->yPos ) )
+        {
+            gridInsert( fleet, index );
+            return site;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Hands what is left of a relay to the relay that still needs it
+ *
+ * @details The Drones from index back to the head take the other relay's
+ *          Disaster number. If that relay hangs off index they become the
+ *          part of it closest to the base station, otherwise it had no Drone
+ *          of its own and they become all of it
+ *
+ * @param in: fleet
+ *            Fleet of all Drones
+ *
+ *            index
+ *            Tail of what is left of the relay
+ *
+ *            disNum
+ *            Disaster number of the relay being torn down
+ *
+ *            keeper
+ *            Disaster number of the relay that needs index
+ *
+ * @return void
+ *
+ * @note O(Drones left)
+ */
+static void handOver( Fleet& fleet, int index, int disNum, int keeper )
+{
+    Relay& relay = fleet.relays[disNum];
+    Relay& kept = fleet.relays[keeper];
+    int current = index;
+
+    while( current >= 0 && fleet.disNum[current] == disNum )
+    {
+        fleet.disNum[current] = keeper;
+        current = fleet.previous[current];
+    }
+
+    if( kept.head >= 0 )
+    {
+        fleet.next[index] = kept.head;
+        fleet.firstDrone[kept.head] = false;
+    }
+    else
+    {
+        kept.tail = index;
+        relayUnshare( fleet, keeper );
+    }
+
+    kept.head = relay.head;
+    kept.length += relay.length;
+    kept.batteryKey += relay.batteryKey;
+}
+
+/**
+ * @brief Lands the Drones of a resolved Disaster's relay
+ *
+ * @details The relay is walked from its tail towards the base station and
+ *          each Drone lands and joins the idle queue, until one is still
+ *          needed by another relay, see neededBy. Every Drone between that
+ *          one and the base is on the other relay's route too, so they are
+ *          handed to it as they are. The registry entry is emptied so its
+ *          Disaster number can be used again
+ *
+ * @param in: fleet
+ *            Fleet of all Drones, batteries current
+ *
+ *            disNum
+ *            Disaster number of the relay
+ *
+ * @return int number of Drones that landed
+ *
+ * @note O(relay length * ( nearby + shared relays ))
+ */
+int teardownRelay( Fleet& fleet, int disNum )
+{
+    vector<int>& nearby = fleet.scratch.nearby;
+    int index = fleet.relays[disNum].tail;
+    int landed = 0;
+    int upstream, keeper;
+
+    relayUnshare( fleet, disNum );
+
+    while( index >= 0 && fleet.disNum[index] == disNum )
+    {
+        keeper = neededBy( fleet, index, nearby );
+        if( keeper >= 0 )
+        {
+            handOver( fleet, index, disNum, keeper );
+            break;
+        }
+
+        upstream = fleet.previous[index];
+        relayRemove( fleet, index );
+        if( upstream >= 0 && fleet.next[upstream] == index )
+        {
+            fleet.next[upstream] = -1;
+        }
+
+        logEvent( fleet, EVENT_RELAY_TORN_DOWN, index, disNum,
+                  fleet.xPos[index], fleet.yPos[index] );
+        fleet.inFlight[index] = false;
+        fleet.dronesUsed--;
+        fleet.xPos[index] = fleet.baseX;
+        fleet.yPos[index] = fleet.baseY;
+        fleet.disNum[index] = -1;
+        fleet.firstDrone[index] = false;
+        fleet.previous[index] = -1;
+        fleet.next[index] = -1;
+        idleInsert( fleet, index );
+        landed++;
+
+        index = upstream;
+    }
+
+    relayReset( fleet, disNum );
+
+    return landed;
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
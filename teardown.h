@@ -0,0 +1,29 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file teardown.h
+ *
+ * @details Header file for relay teardown which provides prototypes for
+ *          landing the Drones of a resolved Disaster
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef TEARDOWN_H
+#define TEARDOWN_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+int teardownRelay( Fleet& fleet, int disNum );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
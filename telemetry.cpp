@@ -0,0 +1,194 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file telemetry.cpp
+ *
+ * @details Implementation file for the telemetry log which provides function
+ *          definitions and documentation
+ *
+ * @Note None
+ */
+
+ // Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef TELEMETRY_CPP
+#define TELEMETRY_CPP
+
+// Header File ////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include "telemetry.h"
+
+using namespace std;
+
+// Begin Function Definitions /////////////////////////////////////////////////
+
+/**
+ * @brief Writer thread body, copies records from the ring to the file until
+ *        the log is closed and the ring is empty
+ *
+ * @details Every pass writes the whole run of records that is ready, up to
+ *          the end of the slot array, with one write call. When the ring is
+ *          empty the thread sleeps for a millisecond
+ *
+ * @param in: telemetry
+ *            Log to drain
+ *
+ * @return void
+ *
+ * @note Only this thread moves tail
+ */
+static void telemetryDrain( Telemetry* telemetry )
+{
+    const unsigned long mask = telemetry->slots.size() - 1;
+    unsigned long head, tail, count;
+
+    while( true )
+    {
+        head = telemetry->head.load( memory_order_acquire );
+        tail = telemetry->tail.load( memory_order_relaxed );
+
+        if( head == tail )
+        {
+            //stopping is set after the last record, so recheck head once
+            if( telemetry->stopping.load( memory_order_acquire )
+                 && telemetry->head.load( memory_order_acquire ) == tail )
+            {
+                break;
+            }
+
+            this_thread::sleep_for( chrono::milliseconds( 1 ) );
+            continue;
+        }
+
+        count = min( head - tail, mask + 1 - ( tail & mask ) );
+        telemetry->file.write(
+                    (const char*)&telemetry->slots[tail & mask],
+                    count * sizeof( TelemetryRecord ) );
+        telemetry->written += count;
+        telemetry->tail.store( tail + count, memory_order_release );
+    }
+
+    telemetry->file.flush();
+}
+
+/**
+ * @brief Creates the log file and starts its writer thread
+ *
+ * @param in: telemetry
+ *            Log to open, must not already be open
+ *
+ *            path
+ *            File to write, replaced if it exists
+ *
+ * @return bool Evidence that the file was created
+ *
+ * @note Set fleet.telemetry to the log afterwards to start recording
+ */
+bool telemetryOpen( Telemetry& telemetry, const char* path )
+{
+    TelemetryHeader header;
+
+    telemetry.file.open( path, ios::binary | ios::trunc );
+    if( !telemetry.file )
+    {
+        return false;
+    }
+
+    memcpy( header.magic, TELEMETRY_MAGIC, sizeof( header.magic ) );
+    header.version = TELEMETRY_VERSION;
+    header.recordSize = sizeof( TelemetryRecord );
+    telemetry.file.write( (const char*)&header, sizeof( header ) );
+
+    telemetry.slots.resize( TELEMETRY_RING_SIZE );
+    telemetry.head.store( 0 );
+    telemetry.tail.store( 0 );
+    telemetry.stopping.store( false );
+    telemetry.written = 0;
+    telemetry.writer = thread( telemetryDrain, &telemetry );
+
+    return true;
+}
+
+/**
+ * @brief Waits for every recorded event to reach the file and closes it
+ *
+ * @param in: telemetry
+ *            Open log
+ *
+ * @return void
+ *
+ * @note Clear fleet.telemetry first, nothing may be recorded after this
+ */
+void telemetryClose( Telemetry& telemetry )
+{
+    telemetry.stopping.store( true, memory_order_release );
+    telemetry.writer.join();
+    telemetry.file.close();
+}
+
+/**
+ * @brief Records an event in the fleet's telemetry log, if it has one
+ *
+ * @details Copies the record into the next free slot of the ring. If the
+ *          writer has fallen a full ring behind, waits for it rather than
+ *          losing the event
+ *
+ * @param in: fleet
+ *            Fleet of all Drones, the event is stamped with its clock
+ *
+ *            type
+ *            One of the EVENT_ constants
+ *
+ *            drone
+ *            Drone the event is about, -1 for none
+ *
+ *            other
+ *            Second value, see the EVENT_ constants, -1 for none
+ *
+ *            xPos
+ *            x coordinate of the event, -1 for none
+ *
+ *            yPos
+ *            y coordinate of the event, -1 for none
+ *
+ * @return void
+ *
+ * @note Only call from the simulation thread, it is the only producer
+ */
+void logEvent( Fleet& fleet, int32_t type, int32_t drone, int32_t other,
+               int32_t xPos, int32_t yPos )
+{
+    Telemetry* telemetry = fleet.telemetry;
+    unsigned long head;
+
+    if( telemetry == NULL )
+    {
+        return;
+    }
+
+    head = telemetry->head.load( memory_order_relaxed );
+    while( head - telemetry->tail.load( memory_order_acquire )
+                                            >= telemetry->slots.size() )
+    {
+        this_thread::yield();
+    }
+
+    TelemetryRecord& record =
+                telemetry->slots[head & ( telemetry->slots.size() - 1 )];
+    record.type = type;
+    record.clock = fleet.clock;
+    record.drone = drone;
+    record.other = other;
+    record.xPos = xPos;
+    record.yPos = yPos;
+    telemetry->head.store( head + 1, memory_order_release );
+}
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif
@@ -0,0 +1,104 @@
+// Program Information ////////////////////////////////////////////////////////
+/**
+ * @file telemetry.h
+ *
+ * @details Header file for the telemetry log which provides prototypes for
+ *          streaming simulation events to a binary file
+ *
+ * @Note None
+ */
+
+// Precompiler directives /////////////////////////////////////////////////////
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+// Header Files ///////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include "structs.h"
+
+using namespace std;
+
+// Global Constants ///////////////////////////////////////////////////////////
+
+static const char TELEMETRY_MAGIC[8] = { 'D', 'R', 'N', 'T', 'E', 'L', 'E', '\0' };
+static const uint32_t TELEMETRY_VERSION = 1;
+static const int TELEMETRY_RING_SIZE = 1 << 16; //records, a power of two
+
+//event types
+static const int32_t EVENT_DISPATCHED = 1; //other = disaster number
+static const int32_t EVENT_REPLACED = 2; //other = replacement Drone
+static const int32_t EVENT_REPLACE_FAILED = 3;
+static const int32_t EVENT_PACKET_HOP = 4;
+static const int32_t EVENT_PACKET_DELIVERED = 5; //drone = entry Drone
+static const int32_t EVENT_PACKET_BATCH = 6; //other = delivered, xPos = dropped
+static const int32_t EVENT_RELAY_REPAIRED = 7; //drone = retired, other = disaster
+static const int32_t EVENT_RELAY_CONSOLIDATED = 8; //drone = landed, other = disaster
+static const int32_t EVENT_RELAY_TORN_DOWN = 9; //drone = landed, other = disaster
+static const int32_t EVENT_DISASTER_RESOLVED = 10; //other = disaster, at its site
+static const int32_t EVENT_DRONE_ADDED = 11;
+static const int32_t EVENT_DRONE_LOST = 12;
+
+// Struct Definitions /////////////////////////////////////////////////////////
+
+/**
+ * @brief TelemetryRecord struct is one fixed-size event in the log
+ *
+ * @details The log file is a TelemetryHeader followed by these records in
+ *          the order the events happened. Unused fields are -1
+ */
+struct TelemetryRecord
+{
+    int32_t type;
+    int32_t clock;
+    int32_t drone;
+    int32_t other;
+    int32_t xPos;
+    int32_t yPos;
+};
+
+/**
+ * @brief TelemetryHeader struct starts every telemetry log
+ */
+struct TelemetryHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+};
+
+/**
+ * @brief Telemetry struct is a single producer, single consumer ring buffer
+ *        of records and the writer thread that drains it to a file
+ *
+ * @details The simulation thread is the only producer and moves head, the
+ *          writer thread is the only consumer and moves tail. Both only ever
+ *          grow, a record lives in slots[position & ( size - 1 )]. head and
+ *          tail sit on their own cache lines so the threads do not share one
+ */
+struct Telemetry
+{
+    vector<TelemetryRecord> slots;
+    alignas( 64 ) atomic<unsigned long> head;
+    alignas( 64 ) atomic<unsigned long> tail;
+    alignas( 64 ) atomic<bool> stopping;
+    long written;
+    ofstream file;
+    thread writer;
+};
+
+// Function Prototypes ////////////////////////////////////////////////////////
+
+bool telemetryOpen( Telemetry& telemetry, const char* path );
+void telemetryClose( Telemetry& telemetry );
+void logEvent( Fleet& fleet, int32_t type, int32_t drone, int32_t other,
+               int32_t xPos, int32_t yPos );
+
+// Terminating precompiler directives  ////////////////////////////////////////
+
+#endif